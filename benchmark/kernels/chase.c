@@ -0,0 +1,59 @@
+/*
+ * Pointer chasing: every load depends on the previous one, so this
+ * measures the load-to-use latency at a given footprint. The chain
+ * visits every line of the footprint once per lap in random order.
+ *
+ * usage: chase [footprint] [steps] [line]
+ *   footprint  bytes covered by the chain (default 16 MB)
+ *   steps      number of dependent loads (default 1M)
+ *   line       distance between the nodes in bytes (default 64)
+ */
+
+#include "kernel.h"
+
+int main(int argc, char **argv)
+{
+    long footprint = arg_long(argc, argv, 1, 16 << 20);
+    long steps = arg_long(argc, argv, 2, 1 << 20);
+    long line = arg_long(argc, argv, 3, 64);
+
+    if (line < (long)sizeof(void *) || line % sizeof(void *)) {
+        fprintf(stderr, "line must be a multiple of the pointer size\n");
+        return 1;
+    }
+
+    long nodes = footprint / line;
+    if (nodes < 2) {
+        fprintf(stderr, "footprint must hold at least two lines\n");
+        return 1;
+    }
+
+    char *mem = xmalloc(nodes * line);
+    long *order = xmalloc(nodes * sizeof(long));
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    /* a random cyclic permutation of the nodes */
+    for (long i = 0; i < nodes; i++)
+        order[i] = i;
+    for (long i = nodes - 1; i > 0; i--) {
+        long j = rng_next(&seed) % (i + 1);
+        long t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (long i = 0; i < nodes; i++)
+        *(void **)(mem + order[i] * line) =
+            mem + order[(i + 1) % nodes] * line;
+    free(order);
+
+    void **p = (void **)mem;
+
+    roi_begin();
+    for (long i = 0; i < steps; i++)
+        p = (void **)*p;
+    roi_end();
+
+    printf("chase: %ld nodes of %ld bytes, %ld steps, end %ld\n",
+           nodes, line, steps, (long)((char *)p - mem) / line);
+    return 0;
+}
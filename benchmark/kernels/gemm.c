@@ -0,0 +1,70 @@
+/*
+ * Dense matrix multiply C += A * B of n x n doubles, either with the
+ * naive triple loop or tiled for cache reuse.
+ *
+ * usage: gemm [n] [tile]
+ *   n     matrix dimension (default 256)
+ *   tile  tile size, 0 for the naive loop (default 0)
+ */
+
+#include "kernel.h"
+
+static void
+gemm_naive(long n, const double *a, const double *b, double *c)
+{
+    for (long i = 0; i < n; i++)
+        for (long j = 0; j < n; j++) {
+            double sum = c[i * n + j];
+            for (long k = 0; k < n; k++)
+                sum += a[i * n + k] * b[k * n + j];
+            c[i * n + j] = sum;
+        }
+}
+
+static void
+gemm_tiled(long n, long t, const double *a, const double *b, double *c)
+{
+    for (long ii = 0; ii < n; ii += t)
+        for (long kk = 0; kk < n; kk += t)
+            for (long jj = 0; jj < n; jj += t) {
+                long ie = ii + t < n ? ii + t : n;
+                long ke = kk + t < n ? kk + t : n;
+                long je = jj + t < n ? jj + t : n;
+                for (long i = ii; i < ie; i++)
+                    for (long k = kk; k < ke; k++) {
+                        double aik = a[i * n + k];
+                        for (long j = jj; j < je; j++)
+                            c[i * n + j] += aik * b[k * n + j];
+                    }
+            }
+}
+
+int main(int argc, char **argv)
+{
+    long n = arg_long(argc, argv, 1, 256);
+    long tile = arg_long(argc, argv, 2, 0);
+
+    double *a = xmalloc(n * n * sizeof(double));
+    double *b = xmalloc(n * n * sizeof(double));
+    double *c = xmalloc(n * n * sizeof(double));
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (long i = 0; i < n * n; i++) {
+        a[i] = (double)(rng_next(&seed) % n + 1);
+        b[i] = (double)(rng_next(&seed) % n + 1);
+        c[i] = 0.0;
+    }
+
+    roi_begin();
+    if (tile > 0)
+        gemm_tiled(n, tile, a, b, c);
+    else
+        gemm_naive(n, a, b, c);
+    roi_end();
+
+    double sum = 0.0;
+    for (long i = 0; i < n * n; i++)
+        sum += c[i];
+    printf("gemm: n %ld, tile %ld, checksum %f\n", n, tile, sum);
+    return 0;
+}
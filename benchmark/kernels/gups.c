@@ -0,0 +1,41 @@
+/*
+ * Random read-modify-write (GUPS): xor random values into random
+ * entries of a table, the access pattern with the least locality.
+ *
+ * usage: gups [table] [updates]
+ *   table    number of 64-bit entries, rounded down to a power of two
+ *            (default 4M, i.e. 32 MB)
+ *   updates  number of updates (default 1M)
+ */
+
+#include "kernel.h"
+
+int main(int argc, char **argv)
+{
+    long entries = arg_long(argc, argv, 1, 1 << 22);
+    long updates = arg_long(argc, argv, 2, 1 << 20);
+
+    long size = 1;
+    while (size * 2 <= entries)
+        size *= 2;
+
+    uint64_t *table = xmalloc(size * sizeof(uint64_t));
+    for (long i = 0; i < size; i++)
+        table[i] = i;
+
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+    roi_begin();
+    for (long i = 0; i < updates; i++) {
+        uint64_t r = rng_next(&seed);
+        table[r & (size - 1)] ^= r;
+    }
+    roi_end();
+
+    uint64_t sum = 0;
+    for (long i = 0; i < size; i++)
+        sum += table[i];
+    printf("gups: %ld entries, %ld updates, checksum %llu\n",
+           size, updates, (unsigned long long)sum);
+    return 0;
+}
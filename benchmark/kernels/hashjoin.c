@@ -0,0 +1,75 @@
+/*
+ * Hash join: build an open-addressed hash table from one relation and
+ * probe it with a second, larger one. The build phase is write heavy
+ * and the probe phase read heavy, both with random accesses.
+ *
+ * usage: hashjoin [build] [probe] [hit_percent]
+ *   build        rows in the build relation (default 1M)
+ *   probe        rows in the probe relation (default 4M)
+ *   hit_percent  percentage of probe keys that are found (default 50)
+ */
+
+#include "kernel.h"
+
+struct bucket {
+    uint64_t key;
+    uint64_t payload;
+};
+
+int main(int argc, char **argv)
+{
+    long build = arg_long(argc, argv, 1, 1 << 20);
+    long probe = arg_long(argc, argv, 2, 1 << 22);
+    long hit_percent = arg_long(argc, argv, 3, 50);
+
+    /* keep the load factor at or below one half */
+    long size = 1;
+    while (size < 2 * build)
+        size *= 2;
+
+    uint64_t *build_keys = xmalloc(build * sizeof(uint64_t));
+    uint64_t *probe_keys = xmalloc(probe * sizeof(uint64_t));
+    struct bucket *table = xmalloc(size * sizeof(struct bucket));
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+    /* build keys are odd, so probe keys made even always miss */
+    for (long i = 0; i < build; i++)
+        build_keys[i] = (rng_next(&seed) | 1);
+    for (long i = 0; i < probe; i++) {
+        if ((long)(rng_next(&seed) % 100) < hit_percent)
+            probe_keys[i] = build_keys[rng_next(&seed) % build];
+        else
+            probe_keys[i] = rng_next(&seed) & ~1ULL;
+    }
+    for (long i = 0; i < size; i++)
+        table[i].key = 0;
+
+    long matches = 0;
+    uint64_t sum = 0;
+
+    roi_begin();
+    for (long i = 0; i < build; i++) {
+        uint64_t h = (build_keys[i] * 0x9E3779B97F4A7C15ULL) & (size - 1);
+        while (table[h].key != 0)
+            h = (h + 1) & (size - 1);
+        table[h].key = build_keys[i];
+        table[h].payload = i;
+    }
+    for (long i = 0; i < probe; i++) {
+        uint64_t key = probe_keys[i];
+        uint64_t h = (key * 0x9E3779B97F4A7C15ULL) & (size - 1);
+        while (table[h].key != 0) {
+            if (table[h].key == key) {
+                matches++;
+                sum += table[h].payload;
+                break;
+            }
+            h = (h + 1) & (size - 1);
+        }
+    }
+    roi_end();
+
+    printf("hashjoin: build %ld, probe %ld, %ld matches, checksum %llu\n",
+           build, probe, matches, (unsigned long long)sum);
+    return 0;
+}
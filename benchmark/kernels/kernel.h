@@ -0,0 +1,57 @@
+/*
+ * Helpers shared by the memory kernels: region-of-interest markers,
+ * argument parsing and a fast random number generator.
+ *
+ * The kernels call roi_begin() once their data is initialised and
+ * roi_end() when the measured part is done. Under gem5 this resets
+ * the stats and dumps them, so the dump taken at roi_end() covers the
+ * kernel alone. Build with -DNO_M5OPS to run natively.
+ */
+
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef NO_M5OPS
+static inline void roi_begin(void) { }
+static inline void roi_end(void) { }
+#else
+#include <gem5/m5ops.h>
+static inline void roi_begin(void) { m5_reset_stats(0, 0); }
+static inline void roi_end(void) { m5_dump_stats(0, 0); }
+#endif
+
+/* Positional argument i as an integer, or def if it is not given. */
+static inline long
+arg_long(int argc, char **argv, int i, long def)
+{
+    return i < argc ? strtol(argv[i], NULL, 0) : def;
+}
+
+/* xorshift64*, good enough for addresses and much faster than rand() */
+static inline uint64_t
+rng_next(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static inline void *
+xmalloc(size_t size)
+{
+    void *p = malloc(size);
+    if (!p) {
+        fprintf(stderr, "cannot allocate %zu bytes\n", size);
+        exit(1);
+    }
+    return p;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Write-heavy log append: records are appended to a circular log and
+ * a small index is updated for every record, as in a write-ahead log
+ * or a key-value store. Almost all traffic is writes, mostly
+ * sequential, which is the worst case for write endurance and write
+ * latency of non-volatile memories.
+ *
+ * usage: logappend [log] [record] [records] [index]
+ *   log      size of the circular log in bytes (default 16 MB)
+ *   record   size of each record in bytes (default 128)
+ *   records  number of records appended (default 256K)
+ *   index    number of index entries (default 64K)
+ */
+
+#include <string.h>
+
+#include "kernel.h"
+
+int main(int argc, char **argv)
+{
+    long log_size = arg_long(argc, argv, 1, 16 << 20);
+    long record = arg_long(argc, argv, 2, 128);
+    long records = arg_long(argc, argv, 3, 1 << 18);
+    long index_size = arg_long(argc, argv, 4, 1 << 16);
+
+    if (record < 16 || record > log_size || index_size < 1) {
+        fprintf(stderr, "invalid record, log or index size\n");
+        return 1;
+    }
+
+    long slots = log_size / record;
+    char *log = xmalloc(slots * record);
+    long *index = xmalloc(index_size * sizeof(long));
+    char *payload = xmalloc(record);
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    memset(payload, 0xA5, record);
+    for (long i = 0; i < index_size; i++)
+        index[i] = -1;
+
+    roi_begin();
+    for (long i = 0; i < records; i++) {
+        uint64_t key = rng_next(&seed);
+        long slot = i % slots;
+        char *dst = log + slot * record;
+
+        /* header with the key and sequence number, then the payload */
+        memcpy(dst, &key, sizeof(key));
+        memcpy(dst + sizeof(key), &i, sizeof(i));
+        memcpy(dst + 16, payload, record - 16);
+
+        index[key % index_size] = slot;
+    }
+    roi_end();
+
+    long used = 0;
+    for (long i = 0; i < index_size; i++)
+        used += index[i] >= 0;
+    printf("logappend: %ld records of %ld bytes, %ld index entries used\n",
+           records, record, used);
+    return 0;
+}
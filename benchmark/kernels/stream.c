@@ -0,0 +1,47 @@
+/*
+ * Streaming kernels: copy (a = b) and triad (a = b + s * c) over
+ * arrays of doubles, as in STREAM.
+ *
+ * usage: stream [elements] [iterations] [kernel]
+ *   elements    length of each array (default 1M, i.e. 8 MB per array)
+ *   iterations  number of passes (default 4)
+ *   kernel      0 = copy and triad, 1 = copy only, 2 = triad only
+ */
+
+#include "kernel.h"
+
+int main(int argc, char **argv)
+{
+    long n = arg_long(argc, argv, 1, 1 << 20);
+    long iters = arg_long(argc, argv, 2, 4);
+    long kernel = arg_long(argc, argv, 3, 0);
+    const double s = 3.0;
+
+    double *a = xmalloc(n * sizeof(double));
+    double *b = xmalloc(n * sizeof(double));
+    double *c = xmalloc(n * sizeof(double));
+
+    for (long i = 0; i < n; i++) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    roi_begin();
+    for (long it = 0; it < iters; it++) {
+        if (kernel != 2)
+            for (long i = 0; i < n; i++)
+                a[i] = b[i];
+        if (kernel != 1)
+            for (long i = 0; i < n; i++)
+                a[i] = b[i] + s * c[i];
+    }
+    roi_end();
+
+    double sum = 0.0;
+    for (long i = 0; i < n; i++)
+        sum += a[i];
+    printf("stream: %ld elements, %ld iterations, checksum %f\n",
+           n, iters, sum);
+    return 0;
+}
@@ -47,6 +47,19 @@ import m5
 from m5.objects import *
 from Caches import *
 
+def connect_llc(options, system, llc):
+    """Connect the last-level cache to the memory bus, through a
+    monitor with a miss attribution probe if requested."""
+    if options.llc_attribution:
+        system.llc_monitor = CommMonitor()
+        llc.mem_side = system.llc_monitor.slave
+        system.llc_monitor.master = system.membus.slave
+        system.llc_attribution = MissAttributionProbe(
+            manager = system.llc_monitor,
+            write_energy = options.llc_write_energy)
+    else:
+        llc.mem_side = system.membus.slave
+
 def config_cache(options, system):
     if options.external_memory_system and (options.caches or options.l2cache):
         print("External caches and internal caches are exclusive options.\n")
@@ -95,7 +108,7 @@ def config_cache(options, system):
         system.l2.cpu_side = system.tol2bus.master
         system.l2.mem_side = system.tol3bus.slave
 	system.l3.cpu_side = system.tol3bus.master
-        system.l3.mem_side = system.membus.slave
+        connect_llc(options, system, system.l3)
 
     elif options.l2cache:
         # Provide a clock for the L2 and the L1-to-L2 bus here as they
@@ -107,7 +120,13 @@ def config_cache(options, system):
 
         system.tol2bus = L2XBar(clk_domain = system.cpu_clk_domain)
         system.l2.cpu_side = system.tol2bus.master
-        system.l2.mem_side = system.membus.slave
+        connect_llc(options, system, system.l2)
+
+    if options.snoop_filter_region_size:
+        for xbar in ('membus', 'tol2bus', 'tol3bus'):
+            if hasattr(system, xbar) and getattr(system, xbar).snoop_filter:
+                getattr(system, xbar).snoop_filter.region_size = \
+                    options.snoop_filter_region_size
 
     if options.memchecker:
         system.memchecker = MemChecker()
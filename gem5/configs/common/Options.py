@@ -111,6 +111,15 @@ def addNoISAOptions(parser):
     parser.add_option("--l2_assoc", type="int", default=8)
     parser.add_option("--l3_assoc", type="int", default=16)
     parser.add_option("--cacheline_size", type="int", default=64)
+    parser.add_option("--snoop-filter-region-size", type="int", default=0,
+                      help="track coherence in the crossbar snoop filters "
+                      "per region of this many bytes instead of per line")
+    parser.add_option("--llc-attribution", action="store_true",
+                      help="attribute last-level cache misses and "
+                      "writebacks to PCs and address regions")
+    parser.add_option("--llc-write-energy", type="float", default=0.0,
+                      help="energy to write a byte to memory (pJ), used "
+                      "to report the write energy per PC and region")
 
     # Enable Ruby
     parser.add_option("--ruby", action="store_true")
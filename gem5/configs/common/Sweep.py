@@ -0,0 +1,188 @@
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Run a sweep of configuration variants from a single invocation of a
+# config script. The script parses its options as usual and hands them
+# to run() before building anything. The parent process then forks a
+# child per run: first an optional warm-up run on the atomic CPU that
+# drops a checkpoint, then one child per variant that builds its own
+# system, restores the warm-up checkpoint and simulates. Every child
+# writes its stats and config into its own output directory, and the
+# parent waits for them and writes a summary.
+#
+# The sweep file has one variant per line, a name followed by the
+# command-line options that differ from the base invocation, e.g.
+#
+#   assoc8   --l3_assoc=8
+#   assoc32  --l3_assoc=32 --l3_size=32MB
+#
+# Blank lines and lines starting with '#' are ignored.
+
+from __future__ import print_function
+
+import os
+import shlex
+import sys
+
+import m5
+from m5 import trace
+from m5.util import fatal
+
+def addOptions(parser):
+    parser.add_option("--sweep", action="store", type="string",
+                      default=None, metavar="FILE",
+                      help="run each configuration variant listed in FILE")
+    parser.add_option("--sweep-warmup", action="store", type="int",
+                      default=0, metavar="N",
+                      help="warm up for N instructions on the atomic CPU "
+                      "once and restore every variant from that checkpoint")
+    parser.add_option("--sweep-jobs", action="store", type="int",
+                      default=1, metavar="J",
+                      help="number of variants simulated at the same time")
+
+def parseSweepFile(filename):
+    variants = []
+    names = set()
+    for line in open(filename):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        fields = shlex.split(line)
+        name, args = fields[0], fields[1:]
+        if name in names:
+            fatal("Sweep variant '%s' is listed twice in %s", name, filename)
+        names.add(name)
+        variants.append((name, args))
+    if not variants:
+        fatal("No variants in sweep file %s", filename)
+    return variants
+
+def _fork(outdir):
+    """Fork the simulator before instantiation. The child continues
+    with its output redirected to outdir."""
+    sys.stdout.flush()
+    sys.stderr.flush()
+    pid = os.fork()
+    if pid != 0:
+        return pid
+
+    m5.options.outdir = outdir
+    if not os.path.isdir(outdir):
+        os.makedirs(outdir)
+    m5.core.setOutputDir(outdir)
+
+    # follow the parent's stdout/stderr redirection into the new outdir
+    if m5.options.redirect_stdout:
+        fd = os.open(os.path.join(outdir, m5.options.stdout_file),
+                     os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+        os.dup2(fd, sys.stdout.fileno())
+        if not m5.options.redirect_stderr:
+            os.dup2(fd, sys.stderr.fileno())
+    if m5.options.redirect_stderr:
+        fd = os.open(os.path.join(outdir, m5.options.stderr_file),
+                     os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+        os.dup2(fd, sys.stderr.fileno())
+
+    # the debug trace continues in the new outdir too
+    if m5.options.debug_format == "binary":
+        trace.binaryOutput(m5.options.debug_file)
+    else:
+        trace.output(m5.options.debug_file)
+    return 0
+
+def _status(status):
+    if os.WIFSIGNALED(status):
+        return -os.WTERMSIG(status)
+    return os.WEXITSTATUS(status)
+
+def run(parser, options):
+    """Run the sweep described by options.sweep. Only returns in a
+    child process, with the options of the run it should simulate."""
+    variants = parseSweepFile(options.sweep)
+    if options.sweep_jobs < 1:
+        fatal("--sweep-jobs must be at least 1")
+
+    base_args = sys.argv[1:]
+    base_outdir = m5.options.outdir
+    cptdir = os.path.join(base_outdir, "warmup")
+
+    if options.sweep_warmup:
+        if options.checkpoint_restore != None or options.fast_forward:
+            fatal("--sweep-warmup can not be combined with checkpoint "
+                  "restore or fast-forwarding")
+        if options.ruby:
+            fatal("--sweep-warmup does not support Ruby")
+
+        pid = _fork(cptdir)
+        if pid == 0:
+            (options, args) = parser.parse_args(base_args)
+            options.sweep = None
+            options.cpu_type = "AtomicSimpleCPU"
+            options.caches = options.l2cache = options.l3cache = False
+            options.maxinsts = options.sweep_warmup
+            options.checkpoint_dir = cptdir
+            options.checkpoint_at_end = True
+            return options
+
+        print("Warming up for %d instructions in %s" %
+              (options.sweep_warmup, cptdir))
+        pid, status = os.waitpid(pid, 0)
+        if _status(status) != 0:
+            fatal("Sweep warm-up failed with status %d", _status(status))
+
+    results = {}
+    running = {}
+    pending = list(variants)
+    while pending or running:
+        while pending and len(running) < options.sweep_jobs:
+            name, extra = pending.pop(0)
+            outdir = os.path.join(base_outdir, name)
+            pid = _fork(outdir)
+            if pid == 0:
+                (options, args) = parser.parse_args(base_args + extra)
+                options.sweep = None
+                if options.sweep_warmup:
+                    options.checkpoint_dir = cptdir
+                    options.checkpoint_restore = 1
+                return options
+            print("Sweep variant %s: %s" % (name, ' '.join(extra)))
+            running[pid] = name
+        pid, status = os.waitpid(-1, 0)
+        name = running.pop(pid)
+        results[name] = _status(status)
+        print("Sweep variant %s finished with status %d" %
+              (name, results[name]))
+
+    with open(os.path.join(base_outdir, "sweep.txt"), 'w') as f:
+        for name, extra in variants:
+            print("%-20s %4d %s %s" % (name, results[name],
+                                      os.path.join(base_outdir, name),
+                                      ' '.join(extra)), file=f)
+
+    failed = [name for name, extra in variants if results[name] != 0]
+    if failed:
+        print("Sweep variants failed: %s" % ' '.join(failed))
+    sys.exit(1 if failed else 0)
@@ -0,0 +1,163 @@
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from __future__ import print_function
+
+import optparse
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+from m5.stats import periodicStatDump
+
+addToPath('../')
+
+from common import MemConfig
+from common.Caches import L3Cache
+
+# this script sweeps the memory-level parallelism of a number of
+# closed-loop traffic generators, each behaving like a core with a
+# given number of independent miss chains, to trace out the
+# bandwidth-latency curve of the memory system, optionally with a
+# shared last-level cache in front of it; each MLP step is one stats
+# dump, with the latency reported by the generators and the bandwidth
+# by the memory controllers
+
+parser = optparse.OptionParser()
+
+parser.add_option("--mem-type", type="choice", default="DDR3_1600_8x8",
+                  choices=MemConfig.mem_names(),
+                  help = "type of memory to use")
+
+parser.add_option("--mem-channels", type="int", default=1,
+                  help = "Number of memory channels")
+
+parser.add_option("--num-gens", type="int", default=64,
+                  help = "Number of closed-loop generators (cores)")
+
+parser.add_option("--max-mlp", type="int", default=16,
+                  help = "Largest number of chains per generator, the "
+                  "sweep doubles the chains from one up to this")
+
+parser.add_option("--think", type="int", default=0,
+                  help = "Think time between a response and the next "
+                  "request of a chain (ticks)")
+
+parser.add_option("--rd_perc", type="int", default=100,
+                  help = "Percentage of read commands")
+
+parser.add_option("--l3-size", type="string", default="",
+                  help = "Size of a shared last-level cache, none if empty")
+
+parser.add_option("--period", type="int", default=100000000,
+                  help = "Ticks spent at each MLP step")
+
+(options, args) = parser.parse_args()
+
+if args:
+    print("Error: script doesn't take any positional arguments")
+    sys.exit(1)
+
+system = System(membus = SystemXBar())
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+mem_range = AddrRange('1GB')
+system.mem_ranges = [mem_range]
+
+# do not worry about reserving space for the backing store
+system.mmap_using_noreserve = True
+
+options.external_memory_system = 0
+options.tlm_memory = 0
+options.elastic_trace_en = 0
+MemConfig.config_mem(options, system)
+
+# there is no point slowing things down by saving any data
+for ctrl in system.mem_ctrls:
+    if isinstance(ctrl, m5.objects.DRAMCtrl):
+        ctrl.null = True
+
+# step the number of chains per generator in powers of two, all
+# generators share the same configuration and roam the whole range
+mlps = []
+mlp = 1
+while mlp <= options.max_mlp:
+    mlps.append(mlp)
+    mlp *= 2
+
+cfg_file_name = "configs/dram/closed_loop.cfg"
+cfg_file = open(cfg_file_name, 'w')
+
+for state, mlp in enumerate(mlps):
+    cfg_file.write("STATE %d %d CLOSED_LOOP %d 0 %d 64 %d %d 0 %d\n" %
+                   (state, options.period, options.rd_perc, mem_range.end,
+                    options.think, options.think, mlp))
+
+cfg_file.write("INIT 0\n")
+
+for state in range(1, len(mlps)):
+    cfg_file.write("TRANSITION %d %d 1\n" % (state - 1, state))
+
+cfg_file.write("TRANSITION %d %d 1\n" % (len(mlps) - 1, len(mlps) - 1))
+
+cfg_file.close()
+
+system.tgen = [ TrafficGen(config_file = cfg_file_name)
+                for i in range(options.num_gens) ]
+
+if options.l3_size:
+    system.l3 = L3Cache(size = options.l3_size)
+    # make sure a cache full of misses does not throttle the cores
+    system.l3.mshrs = max(system.l3.mshrs.value,
+                          options.num_gens * options.max_mlp)
+    system.l3.tgts_per_mshr = max(system.l3.tgts_per_mshr.value,
+                                  options.num_gens)
+    system.tol3bus = L2XBar()
+    for tgen in system.tgen:
+        tgen.port = system.tol3bus.slave
+    system.tol3bus.master = system.l3.cpu_side
+    system.l3.mem_side = system.membus.slave
+else:
+    for tgen in system.tgen:
+        tgen.port = system.membus.slave
+
+# connect the system port even if it is not used in this example
+system.system_port = system.membus.slave
+
+# every period, dump and reset all stats
+periodicStatDump(options.period)
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+m5.simulate(len(mlps) * options.period)
+
+print("Closed-loop sweep with %d generators, MLP %s" %
+      (options.num_gens, ", ".join(str(m) for m in mlps)))
@@ -65,6 +65,7 @@ from common import MemConfig
 from common import CpuConfig
 from common.Caches import *
 from common import Options
+from common import Sweep
 
 
 # Check if KVM support has been enabled, we might need to do VM
@@ -305,6 +306,7 @@ def build_drive_system(np):
 parser = optparse.OptionParser()
 Options.addCommonOptions(parser)
 Options.addFSOptions(parser)
+Sweep.addOptions(parser)
 
 # Add the ruby specific and protocol specific options
 if '--ruby' in sys.argv:
@@ -316,6 +318,10 @@ if args:
     print("Error: script doesn't take any positional arguments")
     sys.exit(1)
 
+# Only returns in the child simulating one run of the sweep
+if options.sweep:
+    options = Sweep.run(parser, options)
+
 # system under test can be any CPU
 (TestCPUClass, test_mem_mode, FutureClass) = Simulation.setCPUClass(options)
 
@@ -62,6 +62,7 @@ from common import Simulation
 from common import CacheConfig
 from common import CpuConfig
 from common import MemConfig
+from common import Sweep
 from common.Caches import *
 from common.cpu2000 import *
 
@@ -126,6 +127,7 @@ def get_processes(options):
 parser = optparse.OptionParser()
 Options.addCommonOptions(parser)
 Options.addSEOptions(parser)
+Sweep.addOptions(parser)
 
 if '--ruby' in sys.argv:
     Ruby.define_options(parser)
@@ -136,6 +138,10 @@ if args:
     print("Error: script doesn't take any positional arguments")
     sys.exit(1)
 
+# Only returns in the child simulating one run of the sweep
+if options.sweep:
+    options = Sweep.run(parser, options)
+
 multiprocesses = []
 numThreads = 1
 
@@ -282,5 +288,10 @@ else:
     CacheConfig.config_cache(options, system)
     MemConfig.config_mem(options, system)
 
+    # Without caches, syscall emulation and the loader can copy to and
+    # from the backing store directly while the system is atomic
+    system.functional_backdoor = not (options.caches or options.l2cache or
+                                      options.external_memory_system)
+
 root = Root(full_system = False, system = system)
 Simulation.run(options, root, system, FutureClass)
@@ -73,6 +73,16 @@ def define_options(parser):
     parser.add_option("--garnet-deadlock-threshold", action="store",
                       type="int", default=50000,
                       help="network-level deadlock threshold.")
+    parser.add_option("--lookahead-bypass", action="store_true",
+                      default=False,
+                      help="""let single-flit packets skip the garnet router
+                            pipeline at idle routers (lookahead routing).""")
+    parser.add_option("--garnet-regions", action="store", type="int",
+                      default=1,
+                      help="""partition the garnet routers into this many
+                            regions, each simulated in its own event queue
+                            (thread). Network interfaces stay with the
+                            controllers in event queue 0.""")
 
 
 def create_network(options, ruby):
@@ -107,6 +117,7 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.lookahead_bypass = options.lookahead_bypass
 
     if options.network == "simple":
         network.setup_buffers()
@@ -120,3 +131,32 @@ def init_network(options, network, InterfaceClass):
         assert(options.network == "garnet2.0")
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+    if options.garnet_regions > 1:
+        assert(options.network == "garnet2.0")
+        partition_network(options, network)
+
+def partition_network(options, network):
+    # Routers are split into contiguous blocks of ids, i.e., bands of rows
+    # for a mesh. Region r runs in event queue r + 1, queue 0 being left
+    # to the NIs, controllers and the rest of the system.
+    num_routers = len(network.routers)
+    regions = min(options.garnet_regions, num_routers)
+    def region_of(router):
+        return 1 + int(router.router_id) * regions // num_routers
+
+    for router in network.routers:
+        router.eventq_index = region_of(router)
+
+    # A link runs in the event queue of the component that feeds it: the
+    # flit link with its source, the credit link with its destination.
+    for link in network.int_links:
+        link.network_link.eventq_index = region_of(link.src_node)
+        link.credit_link.eventq_index = region_of(link.dst_node)
+
+    for link in network.ext_links:
+        # In: NI -> router, Out: router -> NI
+        link.network_links[0].eventq_index = 0
+        link.credit_links[0].eventq_index = region_of(link.int_node)
+        link.network_links[1].eventq_index = region_of(link.int_node)
+        link.credit_links[1].eventq_index = 0
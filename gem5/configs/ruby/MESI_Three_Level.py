@@ -47,6 +47,10 @@ def define_options(parser):
     parser.add_option("--num-clusters", type = "int", default = 1,
             help = "number of clusters in a design in which there are shared\
             caches private to clusters")
+    parser.add_option("--l2-replacement-policy", type = "string",
+            default = None,
+            help = "classic replacement policy (e.g. LRURP, EnergyAwareRP)\
+            used by the shared L2 caches")
     return
 
 def create_system(options, full_system, system, dma_ports, bootmem,
@@ -168,6 +172,10 @@ def create_system(options, full_system, system, dma_ports, bootmem,
             l2_cache = L2Cache(size = options.l2_size,
                                assoc = options.l2_assoc,
                                start_index_bit = l2_index_start)
+            if options.l2_replacement_policy:
+                rp_class = getattr(m5.objects, options.l2_replacement_policy)
+                l2_cache.replacement_policy = ClassicReplacementPolicy(
+                    replacement_policy = rp_class())
 
             l2_cntrl = L2Cache_Controller(
                         version = i * num_l2caches_per_cluster + j,
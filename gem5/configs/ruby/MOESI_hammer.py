@@ -31,6 +31,7 @@ import math
 import m5
 from m5.objects import *
 from m5.defines import buildEnv
+from m5.util import fatal
 from Ruby import create_topology, create_directories
 from Ruby import send_evicts
 
@@ -51,6 +52,18 @@ def define_options(parser):
           help="Hammer: enable Probe Filter")
     parser.add_option("--dir-on", action="store_true",
           help="Hammer: enable Full-bit Directory")
+    parser.add_option("--bloom-snoop-filter", type="string", default=None,
+          help="Hammer: filter broadcast probes with a per-cache Bloom "
+               "filter of the given type (H3, Bulk, Block, MultiGrain "
+               "or LSB_Counting)")
+    parser.add_option("--bloom-filter-size", type="int", default=4096,
+          help="Hammer: entries per cache in the Bloom snoop filter")
+    parser.add_option("--bloom-filter-hashes", type="int", default=4,
+          help="Hammer: hash functions of the H3 Bloom snoop filter")
+    parser.add_option("--bloom-false-positives", action="store_true",
+          default=False,
+          help="Hammer: count the false positives of the Bloom snoop "
+               "filter, keeping an exact copy of the filtered lines")
 
 def create_system(options, full_system, system, dma_ports, bootmem,
                   ruby_system):
@@ -58,6 +71,10 @@ def create_system(options, full_system, system, dma_ports, bootmem,
     if buildEnv['PROTOCOL'] != 'MOESI_hammer':
         panic("This script requires the MOESI_hammer protocol to be built.")
 
+    if options.bloom_snoop_filter and (options.pf_on or options.dir_on):
+        fatal("The Bloom snoop filter replaces broadcasts without a probe "
+              "filter or directory; it cannot be combined with them.")
+
     cpu_sequencers = []
 
     #
@@ -186,6 +203,13 @@ def create_system(options, full_system, system, dma_ports, bootmem,
         dir_cntrl.probe_filter_enabled = options.pf_on
         dir_cntrl.full_bit_dir_enabled = options.dir_on
 
+        dir_cntrl.snoopFilter = RubyBloomSnoopFilter(
+            filter_type = options.bloom_snoop_filter or "H3",
+            filter_size = options.bloom_filter_size,
+            num_hashes = options.bloom_filter_hashes,
+            track_false_positives = options.bloom_false_positives)
+        dir_cntrl.bloom_filter_enabled = bool(options.bloom_snoop_filter)
+
         if options.recycle_latency:
             dir_cntrl.recycle_latency = options.recycle_latency
 
@@ -63,6 +63,11 @@ def define_options(parser):
     parser.add_option("--access-backing-store", action="store_true", default=False,
                       help="Should ruby maintain a second copy of memory")
 
+    parser.add_option("--ruby-cache-snapshot", action="store_true",
+                      default=False,
+                      help="""checkpoint the exact cache state and restore it
+                            directly instead of replaying the cache trace""")
+
     # Options related to cache structure
     parser.add_option("--ports", action="store", type="int", default=4,
                       help="used of transitions per cycle which is a proxy \
@@ -199,6 +204,9 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
         ruby.phys_mem = SimpleMemory(range=system.mem_ranges[0],
                                      in_addr_map=False)
 
+    if options.ruby_cache_snapshot:
+        ruby.cache_snapshot = True
+
 def create_directories(options, mem_ranges, bootmem, ruby_system,
                        system):
     dir_cntrl_nodes = []
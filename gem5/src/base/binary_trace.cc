@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "base/logging.hh"
+
+namespace Trace {
+
+thread_local BinaryTrace::Buffer *BinaryTrace::localBuffer = nullptr;
+
+/** The thread buffers belong to the one binary trace of the run. */
+static bool traceCreated = false;
+
+/** The magic and version every stream starts with */
+static std::vector<char>
+streamHeader()
+{
+    std::vector<char> header(8);
+    std::memcpy(header.data(), "gem5btr", 8);
+    uint32_t version = BinaryTrace::Version;
+    const char *v = reinterpret_cast<const char *>(&version);
+    header.insert(header.end(), v, v + sizeof(version));
+    return header;
+}
+
+/**
+ * The writer thread and the state shared by all logging threads. The
+ * id definitions are queued as soon as an id is assigned, so they
+ * always reach the stream before any message that refers to them.
+ *
+ * The thread is started by the first write of a process. A child
+ * forked by the simulator (e.g. configs/common/Sweep.py) inherits the
+ * writer without its thread, and starts its own.
+ */
+class BinaryTrace::Writer
+{
+  public:
+    /** Full buffers that may be queued before loggers have to wait */
+    static const size_t MaxQueued = 64;
+
+    Writer(std::ostream &stream)
+        : stream(&stream), done(false), busy(false), threadPid(0)
+    {
+        instance = this;
+        static bool registered = false;
+        if (!registered) {
+            pthread_atfork(&Writer::prepareFork, &Writer::parentFork,
+                           &Writer::childFork);
+            registered = true;
+        }
+    }
+
+    ~Writer()
+    {
+        instance = nullptr;
+        if (!thread || threadPid != getpid())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        ready.notify_all();
+        thread->join();
+    }
+
+    void
+    push(std::vector<char> &&data)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        startThread();
+        space.wait(lock, [this]() { return queue.size() < MaxQueued; });
+        queue.push_back(std::move(data));
+        ready.notify_one();
+    }
+
+    /** Take a cleared vector, reusing the ones already written. */
+    std::vector<char>
+    spare()
+    {
+        std::vector<char> data;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free.empty()) {
+            data = std::move(free.back());
+            free.pop_back();
+        }
+        return data;
+    }
+
+    /** Wait until everything queued has been written. */
+    void
+    drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        startThread();
+        space.wait(lock, [this]() { return queue.empty() && !busy; });
+        stream->flush();
+    }
+
+    /**
+     * Write everything queued and then the given data from the calling
+     * thread, unless that would mean waiting for the writer thread.
+     */
+    bool
+    writeNow(const std::vector<std::vector<char> *> &data)
+    {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock() || busy)
+            return false;
+
+        for (const auto &queued : queue)
+            stream->write(queued.data(), queued.size());
+        queue.clear();
+        for (auto d : data) {
+            stream->write(d->data(), d->size());
+            d->clear();
+        }
+        stream->flush();
+        return true;
+    }
+
+    /** Write to another stream, dropping what is not written yet. */
+    void
+    redirect(std::ostream &new_stream)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        startThread();
+        queue.clear();
+        space.wait(lock, [this]() { return !busy; });
+        stream = &new_stream;
+        space.notify_all();
+    }
+
+    std::mutex defLock;
+    std::map<std::string, uint32_t> formats;
+    std::map<std::string, uint32_t> names;
+
+    std::mutex buffersLock;
+    std::vector<Buffer *> buffers;
+
+  private:
+    /** Start the writer thread of this process, with the lock held */
+    void
+    startThread()
+    {
+        if (thread && threadPid == getpid())
+            return;
+        thread.reset(new std::thread(&Writer::run, this));
+        threadPid = getpid();
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ready.wait(lock, [this]() { return done || !queue.empty(); });
+            if (queue.empty())
+                return;
+
+            std::vector<char> data = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+            space.notify_all();
+
+            lock.unlock();
+            stream->write(data.data(), data.size());
+            lock.lock();
+
+            busy = false;
+            data.clear();
+            if (free.size() < MaxQueued)
+                free.push_back(std::move(data));
+            space.notify_all();
+        }
+    }
+
+    /**
+     * Fork with everything queued written and the lock held, so the
+     * child does not inherit it in the middle of an update. The writer thread does not exist in the
+     * child, so the child forgets it, along with the synchronisation
+     * state it may have left behind, and the data it had not written
+     * for the parent.
+     */
+    static void
+    prepareFork()
+    {
+        if (!instance)
+            return;
+        // The child would write the stream's buffer a second time
+        instance->drain();
+        instance->mutex.lock();
+    }
+
+    static void
+    parentFork()
+    {
+        if (instance)
+            instance->mutex.unlock();
+    }
+
+    static void
+    childFork()
+    {
+        if (!instance)
+            return;
+        new (&instance->mutex) std::mutex;
+        new (&instance->ready) std::condition_variable;
+        new (&instance->space) std::condition_variable;
+        instance->thread.release();
+        instance->queue.clear();
+        instance->busy = false;
+    }
+
+    static Writer *instance;
+
+    std::ostream *stream;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable space;
+    std::deque<std::vector<char>> queue;
+    std::vector<std::vector<char>> free;
+    bool done;
+    bool busy;
+    std::unique_ptr<std::thread> thread;
+    /** Process the writer thread runs in */
+    pid_t threadPid;
+};
+
+BinaryTrace::Writer *BinaryTrace::Writer::instance = nullptr;
+
+BinaryTrace::BinaryTrace(std::ostream &stream)
+    : writer(new Writer(stream))
+{
+    fatal_if(traceCreated, "Only one binary trace can be created\n");
+    traceCreated = true;
+    writer->push(streamHeader());
+}
+
+BinaryTrace::~BinaryTrace()
+{
+    flush();
+    delete writer;
+}
+
+BinaryTrace::Buffer &
+BinaryTrace::newThreadBuffer()
+{
+    localBuffer = new Buffer;
+    localBuffer->data.reserve(BufferSize + BufferSize / 4);
+    std::lock_guard<std::mutex> lock(writer->buffersLock);
+    writer->buffers.push_back(localBuffer);
+    return *localBuffer;
+}
+
+std::pair<uint32_t, const std::string *>
+BinaryTrace::defineFormat(const char *fmt)
+{
+    std::lock_guard<std::mutex> lock(writer->defLock);
+    auto it = writer->formats.find(fmt);
+    if (it != writer->formats.end())
+        return std::make_pair(it->second, &it->first);
+
+    uint32_t id = writer->formats.size();
+    it = writer->formats.emplace(fmt, id).first;
+
+    Buffer def;
+    def.put<uint8_t>(FormatDef);
+    def.put<uint32_t>(id);
+    def.putString(fmt, std::strlen(fmt));
+    writer->push(std::move(def.data));
+    return std::make_pair(id, &it->first);
+}
+
+uint32_t
+BinaryTrace::defineName(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(writer->defLock);
+    auto it = writer->names.find(name);
+    if (it != writer->names.end())
+        return it->second;
+
+    uint32_t id = writer->names.size();
+    panic_if(id == NoName, "Too many object names in the binary trace\n");
+    writer->names[name] = id;
+
+    Buffer def;
+    def.put<uint8_t>(NameDef);
+    def.put<uint32_t>(id);
+    def.putString(name.data(), name.size());
+    writer->push(std::move(def.data));
+    return id;
+}
+
+void
+BinaryTrace::submit(Buffer &buf)
+{
+    std::vector<char> data = writer->spare();
+    data.reserve(BufferSize + BufferSize / 4);
+    data.swap(buf.data);
+    writer->push(std::move(data));
+}
+
+void
+BinaryTrace::flush()
+{
+    {
+        // Only called while the simulation threads are idle, so the
+        // buffers of the other threads can be taken here.
+        std::lock_guard<std::mutex> lock(writer->buffersLock);
+        for (auto buf : writer->buffers) {
+            if (!buf->data.empty())
+                submit(*buf);
+        }
+    }
+    writer->drain();
+}
+
+bool
+BinaryTrace::abortFlush(bool others_idle)
+{
+    std::vector<std::vector<char> *> data;
+    std::unique_lock<std::mutex> lock(writer->buffersLock, std::defer_lock);
+    if (others_idle && lock.try_lock()) {
+        for (auto buf : writer->buffers)
+            data.push_back(&buf->data);
+    } else if (localBuffer) {
+        data.push_back(&localBuffer->data);
+    }
+    return writer->writeNow(data);
+}
+
+void
+BinaryTrace::redirect(std::ostream &stream)
+{
+    std::lock_guard<std::mutex> def_lock(writer->defLock);
+    std::lock_guard<std::mutex> lock(writer->buffersLock);
+    for (auto buf : writer->buffers) {
+        buf->data.clear();
+        buf->formats.clear();
+        buf->names.clear();
+    }
+    writer->formats.clear();
+    writer->names.clear();
+    writer->redirect(stream);
+    writer->push(streamHeader());
+}
+
+} // namespace Trace
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A binary backend for debug tracing. Instead of formatting every
+ * message, the logging thread appends the address of the format
+ * string, the object name and the raw arguments to a thread-local
+ * buffer. Format strings and names are replaced by small ids that are
+ * defined once in the stream. Full buffers are handed to a writer
+ * thread, which streams them to the trace file, so the simulation
+ * threads neither format text nor wait for the file system.
+ *
+ * util/decode_binary_trace.py renders a trace as the text the
+ * ostream logger would have printed.
+ *
+ * The stream starts with the magic "gem5btr" and a version number,
+ * followed by records, in host byte order:
+ *   'F' u32 id, u32 length, bytes       define a format string
+ *   'N' u32 id, u32 length, bytes       define an object name
+ *   'M' u64 tick, u32 name id, u32 format id, u8 count, arguments
+ * where each argument is a one byte ArgType followed by its value;
+ * strings are a u32 length and the bytes.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace Trace {
+
+class BinaryTrace
+{
+  public:
+    static const uint32_t Version = 1;
+    /** Name id of messages without an object name */
+    static const uint32_t NoName = 0xffffffff;
+
+    enum RecordType : uint8_t
+    {
+        FormatDef = 'F',
+        NameDef = 'N',
+        Message = 'M',
+    };
+
+    enum ArgType : uint8_t
+    {
+        Signed = 1,
+        Unsigned,
+        Double,
+        Char,
+        String,
+        Pointer,
+    };
+
+    /** Records a buffer accumulates before it goes to the writer */
+    static const size_t BufferSize = 1 << 20;
+
+    BinaryTrace(std::ostream &stream);
+    ~BinaryTrace();
+
+    template <typename ...Args>
+    void
+    log(Tick when, const std::string &name, const char *fmt,
+        const Args &...args)
+    {
+        Buffer &buf = threadBuffer();
+        uint32_t name_id = name.empty() ? NoName : nameId(buf, name);
+        uint32_t fmt_id = formatId(buf, fmt);
+
+        buf.put<uint8_t>(Message);
+        buf.put<uint64_t>(when);
+        buf.put<uint32_t>(name_id);
+        buf.put<uint32_t>(fmt_id);
+        buf.put<uint8_t>(sizeof...(Args));
+        putArgs(buf, args...);
+
+        if (buf.data.size() >= BufferSize)
+            submit(buf);
+    }
+
+    /** Write out everything logged so far, by any thread. */
+    void flush();
+
+    /**
+     * Write out what the calling thread logged without ever waiting,
+     * e.g. on the way down after a panic. The buffers of the other
+     * threads are only taken if they are known to be idle.
+     * @return Whether the data could be written
+     */
+    bool abortFlush(bool others_idle);
+
+    /**
+     * Continue the trace in another stream, e.g. in a child process
+     * forked to simulate on its own. What was not written yet is left
+     * to the old stream, and the ids are defined again in the new one.
+     * Only called while the simulation threads are idle.
+     */
+    void redirect(std::ostream &stream);
+
+  private:
+    struct Buffer
+    {
+        std::vector<char> data;
+        /**
+         * This thread's view of the ids defined in the stream. Format
+         * strings are looked up by address, and the text the id was
+         * defined with is checked in case a caller built the format.
+         */
+        std::unordered_map<const char *,
+                           std::pair<uint32_t, const std::string *>> formats;
+        std::unordered_map<std::string, uint32_t> names;
+
+        template <class T>
+        void
+        put(T value)
+        {
+            size_t size = data.size();
+            data.resize(size + sizeof(T));
+            std::memcpy(&data[size], &value, sizeof(T));
+        }
+
+        void
+        putString(const char *str, size_t len)
+        {
+            put<uint32_t>(len);
+            data.insert(data.end(), str, str + len);
+        }
+    };
+
+    /** How each argument type is encoded */
+    enum ArgKind
+    {
+        CharKind,
+        IntegerKind,
+        FloatKind,
+        CStringKind,
+        StringKind,
+        PointerKind,
+        EnumKind,
+        OtherKind,
+    };
+
+    template <class T>
+    using Kind = std::integral_constant<ArgKind,
+        std::is_same<T, char>::value ? CharKind :
+        std::is_integral<T>::value ? IntegerKind :
+        std::is_enum<T>::value &&
+            std::is_convertible<T, long long>::value ? EnumKind :
+        std::is_floating_point<T>::value ? FloatKind :
+        std::is_convertible<T, const char *>::value ? CStringKind :
+        std::is_same<T, std::string>::value ? StringKind :
+        std::is_pointer<T>::value ? PointerKind : OtherKind>;
+
+    static void putArgs(Buffer &buf) {}
+
+    template <typename T, typename ...Args>
+    static void
+    putArgs(Buffer &buf, const T &arg, const Args &...args)
+    {
+        putArg(buf, arg, Kind<T>());
+        putArgs(buf, args...);
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, CharKind>)
+    {
+        buf.put<uint8_t>(Char);
+        buf.put<char>(arg);
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, IntegerKind>)
+    {
+        if (std::is_signed<T>::value) {
+            buf.put<uint8_t>(Signed);
+            buf.put<int64_t>(arg);
+        } else {
+            buf.put<uint8_t>(Unsigned);
+            buf.put<uint64_t>(arg);
+        }
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, FloatKind>)
+    {
+        buf.put<uint8_t>(Double);
+        buf.put<double>(arg);
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, CStringKind>)
+    {
+        const char *str = arg;
+        if (!str)
+            str = "(null)";
+        buf.put<uint8_t>(String);
+        buf.putString(str, std::strlen(str));
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, StringKind>)
+    {
+        buf.put<uint8_t>(String);
+        buf.putString(arg.data(), arg.size());
+    }
+
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, PointerKind>)
+    {
+        buf.put<uint8_t>(Pointer);
+        buf.put<uint64_t>(reinterpret_cast<uintptr_t>(arg));
+    }
+
+    /**
+     * Plain enums are printed as the integer they convert to, so they
+     * are recorded as one. Scoped enums need an operator<<, which may
+     * print a name, so they are rendered to text as below.
+     */
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, EnumKind>)
+    {
+        typedef typename std::underlying_type<T>::type Int;
+        putArg(buf, static_cast<Int>(arg),
+               std::integral_constant<ArgKind, IntegerKind>());
+    }
+
+    /** Anything else is rendered to text when it is logged. */
+    template <class T>
+    static void
+    putArg(Buffer &buf, const T &arg,
+           std::integral_constant<ArgKind, OtherKind>)
+    {
+        std::ostringstream text;
+        text << arg;
+        putArg(buf, text.str(),
+               std::integral_constant<ArgKind, StringKind>());
+    }
+
+    Buffer &
+    threadBuffer()
+    {
+        return localBuffer ? *localBuffer : newThreadBuffer();
+    }
+
+    uint32_t
+    formatId(Buffer &buf, const char *fmt)
+    {
+        auto it = buf.formats.find(fmt);
+        if (it != buf.formats.end() &&
+            std::strcmp(fmt, it->second.second->c_str()) == 0) {
+            return it->second.first;
+        }
+        return (buf.formats[fmt] = defineFormat(fmt)).first;
+    }
+
+    uint32_t
+    nameId(Buffer &buf, const std::string &name)
+    {
+        auto it = buf.names.find(name);
+        if (it != buf.names.end())
+            return it->second;
+        return buf.names[name] = defineName(name);
+    }
+
+    Buffer &newThreadBuffer();
+    std::pair<uint32_t, const std::string *> defineFormat(const char *fmt);
+    uint32_t defineName(const std::string &name);
+
+    /** Hand the data of a buffer to the writer thread. */
+    void submit(Buffer &buf);
+
+    class Writer;
+    Writer *writer;
+
+    static thread_local Buffer *localBuffer;
+};
+
+} // namespace Trace
+
+#endif // __BASE_BINARY_TRACE_HH__
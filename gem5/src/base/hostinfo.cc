@@ -37,6 +37,12 @@
 
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+
+#endif
+
 #include "base/hostinfo.hh"
 
 #include <cctype>
@@ -45,8 +51,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <string>
+#include <vector>
 
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
 #include "base/types.hh"
@@ -120,3 +129,57 @@ memUsage()
     return procInfo("/proc/self/status", "VmSize:");
 #endif
 }
+
+bool
+bindThreadToHostNode(int node)
+{
+#ifdef __linux__
+    ifstream cpulist(csprintf("/sys/devices/system/node/node%d/cpulist",
+                              node));
+    string list;
+    if (!getline(cpulist, list))
+        return false;
+
+    // the list looks like "0-7,16-23"
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    vector<string> ranges;
+    tokenize(ranges, list, ',');
+    for (const auto &range : ranges) {
+        size_t dash = range.find('-');
+        int first, last;
+        if (!to_number(range.substr(0, dash), first))
+            return false;
+        last = first;
+        if (dash != string::npos && !to_number(range.substr(dash + 1), last))
+            return false;
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &cpus);
+    }
+
+    // on Linux, pid 0 is the calling thread rather than the process
+    return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+}
+
+bool
+bindMemoryToHostNode(void *addr, size_t len, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // MPOL_PREFERRED, from <numaif.h> which comes with libnuma
+    const int mpol_preferred = 1;
+    const int bits = 8 * sizeof(unsigned long);
+
+    if (node < 0)
+        return false;
+
+    vector<unsigned long> nodes(node / bits + 1, 0);
+    nodes[node / bits] |= 1UL << (node % bits);
+    return syscall(SYS_mbind, addr, len, mpol_preferred, nodes.data(),
+                   nodes.size() * bits + 1, 0) == 0;
+#else
+    return false;
+#endif
+}
@@ -48,4 +48,23 @@ uint64_t procInfo(const char *filename, const char *target);
  */
 uint64_t memUsage();
 
+/**
+ * Restrict the calling thread to the CPUs of a host NUMA node.
+ *
+ * @param node Host NUMA node
+ * @return Whether the thread could be bound
+ */
+bool bindThreadToHostNode(int node);
+
+/**
+ * Make the pages of a memory region that are not yet touched prefer a
+ * host NUMA node, falling back to other nodes when it is full.
+ *
+ * @param addr Start of the region, page aligned
+ * @param len Length of the region
+ * @param node Host NUMA node
+ * @return Whether the policy could be set
+ */
+bool bindMemoryToHostNode(void *addr, size_t len, int node);
+
 #endif // __HOSTINFO_HH__
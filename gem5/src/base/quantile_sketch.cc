@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/quantile_sketch.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+
+constexpr double QuantileSketch::MinValue;
+
+QuantileSketch::QuantileSketch(double relative_accuracy, size_t max_bins)
+    : accuracy(relative_accuracy), binLimit(max_bins),
+      gamma((1 + relative_accuracy) / (1 - relative_accuracy)),
+      invLogGamma(1 / std::log(gamma)), offset(0),
+      zeroCount(0), total(0), sumValue(0), minValue(0), maxValue(0)
+{
+    fatal_if(relative_accuracy <= 0 || relative_accuracy >= 1,
+             "Quantile sketch accuracy must be in (0, 1)\n");
+    fatal_if(max_bins < 2, "Quantile sketch needs at least two bins\n");
+}
+
+void
+QuantileSketch::addToBin(int index, uint64_t count)
+{
+    if (bins.empty()) {
+        offset = index;
+        bins.push_back(count);
+        return;
+    }
+
+    if (index < offset) {
+        // Collapsed buckets are never re-opened below the lowest one
+        size_t grow = offset - index;
+        if (bins.size() == binLimit) {
+            bins[0] += count;
+            return;
+        }
+        grow = std::min(grow, binLimit - bins.size());
+        bins.insert(bins.begin(), grow, 0);
+        offset -= grow;
+        bins[std::max(index - offset, 0)] += count;
+        return;
+    }
+
+    size_t pos = index - offset;
+    if (pos >= bins.size()) {
+        bins.resize(pos + 1, 0);
+        if (bins.size() > binLimit) {
+            // Fold the lowest buckets into the lowest one kept
+            size_t excess = bins.size() - binLimit;
+            uint64_t folded = 0;
+            for (size_t i = 0; i <= excess; i++)
+                folded += bins[i];
+            bins.erase(bins.begin(), bins.begin() + excess);
+            bins[0] = folded;
+            offset += excess;
+            pos -= excess;
+        }
+    }
+    bins[pos] += count;
+}
+
+void
+QuantileSketch::merge(const QuantileSketch &other)
+{
+    fatal_if(other.accuracy != accuracy,
+             "Merging quantile sketches of different accuracy\n");
+
+    if (!other.total)
+        return;
+
+    for (size_t i = 0; i < other.bins.size(); i++) {
+        if (other.bins[i])
+            addToBin(other.offset + i, other.bins[i]);
+    }
+    zeroCount += other.zeroCount;
+
+    if (!total || other.minValue < minValue)
+        minValue = other.minValue;
+    if (!total || other.maxValue > maxValue)
+        maxValue = other.maxValue;
+    total += other.total;
+    sumValue += other.sumValue;
+}
+
+double
+QuantileSketch::quantile(double q) const
+{
+    if (!total)
+        return 0;
+
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = q * (total - 1);
+
+    uint64_t seen = zeroCount;
+    if (rank < seen)
+        return 0;
+
+    for (size_t i = 0; i < bins.size(); i++) {
+        seen += bins[i];
+        if (rank < seen)
+            return std::min(std::max(value(offset + i), minValue), maxValue);
+    }
+    return maxValue;
+}
+
+void
+QuantileSketch::reset()
+{
+    bins.clear();
+    offset = 0;
+    zeroCount = 0;
+    total = 0;
+    sumValue = 0;
+    minValue = 0;
+    maxValue = 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A mergeable quantile sketch with bounded relative error, following
+ * DDSketch. Positive values are counted in buckets whose bounds grow
+ * geometrically by gamma = (1 + a) / (1 - a), so any quantile can be
+ * read back within a relative error a of the true value, whatever the
+ * range of the samples. Updating is O(1), and two sketches with the
+ * same accuracy are merged by adding their buckets. The number of
+ * buckets is bounded; once exceeded, the lowest buckets are collapsed,
+ * which only affects the accuracy of the lowest quantiles.
+ */
+
+#ifndef __BASE_QUANTILE_SKETCH_HH__
+#define __BASE_QUANTILE_SKETCH_HH__
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class QuantileSketch
+{
+  public:
+    /**
+     * @param relative_accuracy Relative error bound of the quantiles
+     * @param max_bins Maximum number of buckets kept
+     */
+    QuantileSketch(double relative_accuracy = 0.01, size_t max_bins = 2048);
+
+    /** Add a value, values below MinValue count as zero. */
+    void
+    sample(double value, uint64_t count = 1)
+    {
+        if (!count)
+            return;
+
+        if (value < MinValue) {
+            zeroCount += count;
+        } else {
+            addToBin(index(value), count);
+        }
+
+        if (total == 0 || value < minValue)
+            minValue = value;
+        if (total == 0 || value > maxValue)
+            maxValue = value;
+        total += count;
+        sumValue += value * count;
+    }
+
+    /** Add all samples of another sketch with the same accuracy. */
+    void merge(const QuantileSketch &other);
+
+    /**
+     * The value at quantile q, e.g. 0.99 for the 99th percentile, or
+     * zero if the sketch is empty.
+     */
+    double quantile(double q) const;
+
+    uint64_t count() const { return total; }
+    double sum() const { return sumValue; }
+    double min() const { return total ? minValue : 0; }
+    double max() const { return total ? maxValue : 0; }
+    double mean() const { return total ? sumValue / total : 0; }
+
+    double relativeAccuracy() const { return accuracy; }
+    size_t maxBins() const { return binLimit; }
+
+    void reset();
+
+    /** Smallest value counted in a bucket rather than as zero */
+    static constexpr double MinValue = 1e-9;
+
+  private:
+    int
+    index(double value) const
+    {
+        return (int)std::ceil(std::log(value) * invLogGamma);
+    }
+
+    /** The value reported for a bucket, in the middle of its range */
+    double
+    value(int index) const
+    {
+        return 2 * std::pow(gamma, index) / (gamma + 1);
+    }
+
+    void addToBin(int index, uint64_t count);
+
+    double accuracy;
+    size_t binLimit;
+    double gamma;
+    double invLogGamma;
+
+    /** bins[i] counts the values of bucket offset + i */
+    std::vector<uint64_t> bins;
+    int offset;
+
+    uint64_t zeroCount;
+    uint64_t total;
+    double sumValue;
+    double minValue;
+    double maxValue;
+};
+
+#endif // __BASE_QUANTILE_SKETCH_HH__
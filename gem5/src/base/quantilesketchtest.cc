@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "base/quantile_sketch.hh"
+
+namespace {
+
+/** Values spread over six orders of magnitude, in a fixed order. */
+std::vector<double>
+testValues(size_t n)
+{
+    std::vector<double> values;
+    uint32_t seed = 1;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        values.push_back(std::pow(10.0, (seed >> 8) % 6000 / 1000.0));
+    }
+    return values;
+}
+
+/** The value at quantile q of sorted values, as the sketch ranks it */
+double
+exactQuantile(const std::vector<double> &sorted, double q)
+{
+    return sorted[(size_t)(q * (sorted.size() - 1))];
+}
+
+const double quantiles[] = { 0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99,
+                             0.999, 1.0 };
+
+} // anonymous namespace
+
+TEST(QuantileSketchTest, Empty)
+{
+    QuantileSketch sketch;
+    EXPECT_EQ(sketch.count(), 0);
+    EXPECT_EQ(sketch.quantile(0.5), 0);
+    EXPECT_EQ(sketch.min(), 0);
+    EXPECT_EQ(sketch.max(), 0);
+    EXPECT_EQ(sketch.mean(), 0);
+}
+
+TEST(QuantileSketchTest, RelativeError)
+{
+    const double accuracy = 0.01;
+    QuantileSketch sketch(accuracy);
+    std::vector<double> values = testValues(100000);
+    for (double v : values)
+        sketch.sample(v);
+
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(sketch.count(), values.size());
+    EXPECT_EQ(sketch.min(), values.front());
+    EXPECT_EQ(sketch.max(), values.back());
+    for (double q : quantiles) {
+        double exact = exactQuantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), exact, accuracy * exact)
+            << "quantile " << q;
+    }
+}
+
+TEST(QuantileSketchTest, Zeros)
+{
+    QuantileSketch sketch;
+    sketch.sample(0, 90);
+    sketch.sample(100, 10);
+
+    EXPECT_EQ(sketch.count(), 100);
+    EXPECT_EQ(sketch.quantile(0.5), 0);
+    EXPECT_NEAR(sketch.quantile(0.95), 100, 1);
+    EXPECT_EQ(sketch.mean(), 10);
+}
+
+TEST(QuantileSketchTest, Merge)
+{
+    std::vector<double> values = testValues(20000);
+    QuantileSketch all, first, second;
+    for (size_t i = 0; i < values.size(); i++) {
+        all.sample(values[i]);
+        (i % 3 ? first : second).sample(values[i]);
+    }
+
+    first.merge(second);
+    EXPECT_EQ(first.count(), all.count());
+    EXPECT_EQ(first.min(), all.min());
+    EXPECT_EQ(first.max(), all.max());
+    EXPECT_NEAR(first.sum(), all.sum(), 1e-9 * all.sum());
+    for (double q : quantiles)
+        EXPECT_EQ(first.quantile(q), all.quantile(q)) << "quantile " << q;
+
+    // Merging an empty sketch changes nothing
+    first.merge(QuantileSketch());
+    EXPECT_EQ(first.count(), all.count());
+    EXPECT_EQ(first.quantile(0.5), all.quantile(0.5));
+}
+
+TEST(QuantileSketchTest, BinCollapsing)
+{
+    // Six orders of magnitude need about 700 buckets at 1% accuracy,
+    // keep far fewer so the lowest ones are collapsed
+    const double accuracy = 0.01;
+    const size_t max_bins = 100;
+    std::vector<double> values = testValues(100000);
+    QuantileSketch sketch(accuracy, max_bins), merged(accuracy, max_bins);
+    for (size_t i = 0; i < values.size(); i++) {
+        sketch.sample(values[i]);
+        QuantileSketch part(accuracy, max_bins);
+        part.sample(values[i]);
+        merged.merge(part);
+    }
+
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(sketch.count(), values.size());
+    EXPECT_EQ(merged.count(), values.size());
+
+    // The kept buckets span a factor of gamma^max_bins below the
+    // maximum, the quantiles above that are still exact to within the
+    // accuracy, the ones below are raised to the lowest kept bucket
+    double gamma = (1 + accuracy) / (1 - accuracy);
+    double lowest = values.back() / std::pow(gamma, max_bins - 1);
+    for (double q : quantiles) {
+        double exact = exactQuantile(values, q);
+        for (const QuantileSketch *s : { &sketch, &merged }) {
+            if (exact > lowest) {
+                EXPECT_NEAR(s->quantile(q), exact, accuracy * exact)
+                    << "quantile " << q;
+            } else {
+                EXPECT_GE(s->quantile(q), exact) << "quantile " << q;
+                EXPECT_LE(s->quantile(q), lowest * gamma)
+                    << "quantile " << q;
+            }
+        }
+    }
+}
+
+TEST(QuantileSketchTest, Reset)
+{
+    QuantileSketch sketch;
+    sketch.sample(5, 10);
+    sketch.reset();
+    EXPECT_EQ(sketch.count(), 0);
+    EXPECT_EQ(sketch.quantile(0.5), 0);
+
+    sketch.sample(7);
+    EXPECT_NEAR(sketch.quantile(0.5), 7, 0.07);
+}
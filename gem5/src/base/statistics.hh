@@ -69,6 +69,7 @@
 #include "base/cast.hh"
 #include "base/cprintf.hh"
 #include "base/intmath.hh"
+#include "base/quantile_sketch.hh"
 #include "base/str.hh"
 #include "base/types.hh"
 
@@ -2886,6 +2887,167 @@ class SparseHistogram : public SparseHistBase<SparseHistogram, SparseHistStor>
     }
 };
 
+template <class Stat>
+class PercentileInfoProxy : public InfoProxy<Stat, PercentileInfo>
+{
+  public:
+    PercentileInfoProxy(Stat &stat) : InfoProxy<Stat, PercentileInfo>(stat) {}
+};
+
+/**
+ * Implementation of a percentile stat. The storage class is
+ * determined by the Storage template.
+ */
+template <class Derived, class Stor>
+class PercentileBase : public DataWrap<Derived, PercentileInfoProxy>
+{
+  public:
+    typedef PercentileInfoProxy<Derived> Info;
+    typedef Stor Storage;
+    typedef typename Stor::Params Params;
+
+  protected:
+    /** The storage for this stat. */
+    char storage[sizeof(Storage)];
+
+  protected:
+    Storage *
+    data()
+    {
+        return reinterpret_cast<Storage *>(storage);
+    }
+
+    const Storage *
+    data() const
+    {
+        return reinterpret_cast<const Storage *>(storage);
+    }
+
+    void
+    doInit()
+    {
+        new (storage) Storage(this->info());
+        this->setInit();
+    }
+
+  public:
+    PercentileBase() { }
+
+    /**
+     * Add a value to the stat n times.
+     * @param v The value to add.
+     * @param n The number of times to add it, defaults to 1.
+     */
+    template <typename U>
+    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+
+    /** Add all samples of another stat with the same accuracy. */
+    void merge(const Derived &other) { data()->merge(*other.data()); }
+
+    /** The value at quantile q, e.g. 0.99 for the 99th percentile. */
+    Result quantile(double q) const { return data()->quantile(q); }
+
+    size_type size() const { return data()->size(); }
+    bool zero() const { return data()->zero(); }
+
+    void
+    prepare()
+    {
+        Info *info = this->info();
+        data()->prepare(info, info->data);
+    }
+
+    void
+    reset()
+    {
+        data()->reset(this->info());
+    }
+};
+
+/**
+ * Storage for a percentile stat, a QuantileSketch: every reported
+ * percentile is within a relative error of the true value, using a
+ * bounded number of buckets and no bucket sizing up front.
+ */
+class PercentileStor
+{
+  public:
+    /** The parameters for a percentile stat. */
+    struct Params : public StorageParams
+    {
+        /** The relative error bound of the percentiles. */
+        double accuracy;
+        /** The maximum number of sketch buckets. */
+        size_type maxBins;
+        /** The quantiles printed, in [0, 1]. */
+        std::vector<double> quantiles;
+    };
+
+  private:
+    QuantileSketch sketch;
+
+  public:
+    PercentileStor(Info *info)
+        : sketch(safe_cast<const Params *>(info->storageParams)->accuracy,
+                 safe_cast<const Params *>(info->storageParams)->maxBins)
+    { }
+
+    void sample(Counter val, int number) { sketch.sample(val, number); }
+    void merge(const PercentileStor &other) { sketch.merge(other.sketch); }
+    Result quantile(double q) const { return sketch.quantile(q); }
+
+    /** A percentile stat is printed as one group. */
+    size_type size() const { return 1; }
+    bool zero() const { return sketch.count() == 0; }
+
+    void
+    prepare(Info *info, PercentileData &data)
+    {
+        const Params *params = safe_cast<const Params *>(info->storageParams);
+
+        data.samples = sketch.count();
+        data.mean = sketch.mean();
+        data.min = sketch.min();
+        data.max = sketch.max();
+        data.quantiles = params->quantiles;
+        data.values.resize(params->quantiles.size());
+        for (off_type i = 0; i < params->quantiles.size(); ++i)
+            data.values[i] = sketch.quantile(params->quantiles[i]);
+    }
+
+    void reset(Info *info) { sketch.reset(); }
+};
+
+/**
+ * A stat reporting the mean, extremes and selected percentiles of a
+ * sampled value, typically a latency, with bounded relative error.
+ * Unlike a Histogram it needs no bucket range up front, so the tail
+ * of the distribution is not lost in a coarse last bucket.
+ */
+class Percentiles : public PercentileBase<Percentiles, PercentileStor>
+{
+  public:
+    /**
+     * Set the parameters of the stat. @sa PercentileStor::Params
+     * @param quantiles The quantiles to print, in [0, 1]
+     * @param accuracy The relative error bound of the percentiles
+     * @param max_bins The maximum number of sketch buckets
+     * @return A reference to this stat.
+     */
+    Percentiles &
+    init(const std::vector<double> &quantiles = { 0.5, 0.9, 0.99, 0.999 },
+         double accuracy = 0.01, size_type max_bins = 2048)
+    {
+        PercentileStor::Params *params = new PercentileStor::Params;
+        params->accuracy = accuracy;
+        params->maxBins = max_bins;
+        params->quantiles = quantiles;
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 class Temp;
 /**
  * A formula for statistics that is calculated when printed. A formula is
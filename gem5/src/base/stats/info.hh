@@ -254,6 +254,25 @@ class SparseHistInfo : public Info
     SparseHistData data;
 };
 
+/** Data structure of percentile stat */
+struct PercentileData
+{
+    Counter samples;
+    Result mean;
+    Result min;
+    Result max;
+    /** The quantiles printed and their values */
+    std::vector<double> quantiles;
+    VResult values;
+};
+
+class PercentileInfo : public Info
+{
+  public:
+    /** Local storage for the entry values, used for printing. */
+    PercentileData data;
+};
+
 } // namespace Stats
 
 #endif // __BASE_STATS_INFO_HH__
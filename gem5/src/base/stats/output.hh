@@ -44,6 +44,7 @@ class VectorDistInfo;
 class Vector2dInfo;
 class FormulaInfo;
 class SparseHistInfo; // Sparse histogram
+class PercentileInfo;
 
 struct Output
 {
@@ -59,6 +60,7 @@ struct Output
     virtual void visit(const Vector2dInfo &info) = 0;
     virtual void visit(const FormulaInfo &info) = 0;
     virtual void visit(const SparseHistInfo &info) = 0; // Sparse histogram
+    virtual void visit(const PercentileInfo &info) = 0;
 };
 
 } // namespace Stats
@@ -45,6 +45,7 @@
 #endif
 #include "base/stats/text.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -52,6 +53,7 @@
 #include <string>
 
 #include "base/cast.hh"
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/stats/info.hh"
 #include "base/str.hh"
@@ -735,6 +737,49 @@ Text::visit(const SparseHistInfo &info)
     print(*stream);
 }
 
+void
+Text::visit(const PercentileInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const PercentileData &data = info.data;
+    string base = info.name + info.separatorString;
+
+    ScalarPrint print;
+    print.precision = info.precision;
+    print.flags = info.flags;
+    print.descriptions = descriptions;
+    print.desc = info.desc;
+    print.pdf = NAN;
+    print.cdf = NAN;
+
+    print.name = base + "samples";
+    print.value = data.samples;
+    print(*stream);
+
+    print.name = base + "mean";
+    print.value = data.mean;
+    print(*stream);
+
+    print.name = base + "min_value";
+    print.value = data.min;
+    print(*stream);
+
+    print.name = base + "max_value";
+    print.value = data.max;
+    print(*stream);
+
+    // Name the quantiles after their percentage, p99_9 for 0.999
+    for (off_type i = 0; i < data.quantiles.size(); ++i) {
+        string pct = csprintf("%g", data.quantiles[i] * 100);
+        std::replace(pct.begin(), pct.end(), '.', '_');
+        print.name = base + "p" + pct;
+        print.value = data.values[i];
+        print(*stream);
+    }
+}
+
 Output *
 initText(const string &filename, bool desc)
 {
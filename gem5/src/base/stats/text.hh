@@ -69,6 +69,7 @@ class Text : public Output
     virtual void visit(const Vector2dInfo &info);
     virtual void visit(const FormulaInfo &info);
     virtual void visit(const SparseHistInfo &info);
+    virtual void visit(const PercentileInfo &info);
 
     // Implement Output
     virtual bool valid() const;
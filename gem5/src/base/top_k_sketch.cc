@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/top_k_sketch.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+TopKSketch::TopKSketch(unsigned _k, unsigned _width, unsigned _depth)
+    : k(_k), width(ceilPow2(std::max(_width, 1U))), depth(_depth),
+      counters(width * depth, 0), minKey(0), minCount(0), totalCount(0)
+{
+    fatal_if(k == 0, "TopKSketch must track at least one key\n");
+    fatal_if(depth == 0, "TopKSketch needs at least one row\n");
+    candidates.reserve(k);
+}
+
+void
+TopKSketch::add(uint64_t key, uint64_t inc)
+{
+    if (!inc)
+        return;
+
+    totalCount += inc;
+
+    // conservative update, only raise the counters that hold the
+    // minimum, which tightens the estimates at no extra cost
+    uint64_t est = estimate(key) + inc;
+    for (unsigned r = 0; r < depth; ++r) {
+        uint64_t &c = counters[slot(key, r)];
+        c = std::max(c, est);
+    }
+
+    auto i = candidates.find(key);
+    if (i != candidates.end()) {
+        i->second = est;
+        if (candidates.size() == k && key == minKey)
+            findMin();
+    } else if (candidates.size() < k) {
+        candidates.emplace(key, est);
+        if (candidates.size() == k)
+            findMin();
+    } else if (est > minCount) {
+        candidates.erase(minKey);
+        candidates.emplace(key, est);
+        findMin();
+    }
+}
+
+uint64_t
+TopKSketch::estimate(uint64_t key) const
+{
+    uint64_t est = UINT64_MAX;
+    for (unsigned r = 0; r < depth; ++r)
+        est = std::min(est, counters[slot(key, r)]);
+    return est;
+}
+
+std::vector<TopKSketch::Entry>
+TopKSketch::top() const
+{
+    std::vector<Entry> entries(candidates.begin(), candidates.end());
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                  return a.second > b.second ||
+                      (a.second == b.second && a.first < b.first);
+              });
+    return entries;
+}
+
+void
+TopKSketch::reset()
+{
+    std::fill(counters.begin(), counters.end(), 0);
+    candidates.clear();
+    minKey = 0;
+    minCount = 0;
+    totalCount = 0;
+}
+
+void
+TopKSketch::findMin()
+{
+    auto m = std::min_element(candidates.begin(), candidates.end(),
+                              [](const Entry &a, const Entry &b) {
+                                  return a.second < b.second;
+                              });
+    minKey = m->first;
+    minCount = m->second;
+}
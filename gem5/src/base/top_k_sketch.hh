@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A bounded heavy-hitter counter: a count-min sketch estimates the
+ * count of any key in fixed space, and the K keys with the largest
+ * estimates are kept as candidates. Estimates never undercount, and
+ * overcount by at most 2N/width with probability 1 - 2^-depth, N
+ * being the total count, so the heaviest keys are found with memory
+ * independent of the number of distinct keys.
+ */
+
+#ifndef __BASE_TOP_K_SKETCH_HH__
+#define __BASE_TOP_K_SKETCH_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class TopKSketch
+{
+  public:
+    typedef std::pair<uint64_t, uint64_t> Entry;
+
+    /**
+     * @param k Number of heavy hitters tracked
+     * @param width Counters per row, rounded up to a power of two
+     * @param depth Number of rows (independent hash functions)
+     */
+    TopKSketch(unsigned k = 32, unsigned width = 1024, unsigned depth = 4);
+
+    /** Add inc to the count of key. */
+    void add(uint64_t key, uint64_t inc = 1);
+
+    /** Estimated count of a key. */
+    uint64_t estimate(uint64_t key) const;
+
+    /** Sum of all counts added. */
+    uint64_t total() const { return totalCount; }
+
+    /** The tracked keys and their estimates, largest first. */
+    std::vector<Entry> top() const;
+
+    /** Forget all counts. */
+    void reset();
+
+  private:
+    /** Counter of a key in the given row */
+    size_t
+    slot(uint64_t key, unsigned row) const
+    {
+        // splitmix64 finaliser, seeded per row
+        uint64_t h = key + 0x9E3779B97F4A7C15ULL * (row + 1);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return row * width + (h & (width - 1));
+    }
+
+    /** Find the candidate with the smallest estimate. */
+    void findMin();
+
+    const unsigned k;
+    const unsigned width;
+    const unsigned depth;
+
+    /** depth rows of width counters */
+    std::vector<uint64_t> counters;
+
+    /** Heavy-hitter candidates and their estimates */
+    std::unordered_map<uint64_t, uint64_t> candidates;
+
+    /** Candidate with the smallest estimate, valid when full */
+    uint64_t minKey;
+    uint64_t minCount;
+
+    uint64_t totalCount;
+};
+
+#endif // __BASE_TOP_K_SKETCH_HH__
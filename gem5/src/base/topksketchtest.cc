@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+#include "base/top_k_sketch.hh"
+
+TEST(TopKSketchTest, Empty)
+{
+    TopKSketch sketch;
+    EXPECT_EQ(sketch.total(), 0);
+    EXPECT_EQ(sketch.estimate(42), 0);
+    EXPECT_TRUE(sketch.top().empty());
+}
+
+TEST(TopKSketchTest, ExactWhenFewKeys)
+{
+    // Fewer keys than counters per row, every estimate is exact
+    TopKSketch sketch(4, 1024, 4);
+    for (uint64_t key = 1; key <= 4; key++)
+        sketch.add(key * 1000, key * 10);
+
+    std::vector<TopKSketch::Entry> top = sketch.top();
+    ASSERT_EQ(top.size(), 4);
+    for (uint64_t i = 0; i < 4; i++) {
+        EXPECT_EQ(top[i].first, (4 - i) * 1000);
+        EXPECT_EQ(top[i].second, (4 - i) * 10);
+    }
+    EXPECT_EQ(sketch.total(), 100);
+}
+
+TEST(TopKSketchTest, NeverUndercounts)
+{
+    TopKSketch sketch(8, 64, 4);
+    std::map<uint64_t, uint64_t> exact;
+    uint64_t key = 1;
+    for (int i = 0; i < 20000; i++) {
+        key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t k = (key >> 33) % 2000;
+        sketch.add(k);
+        exact[k]++;
+    }
+
+    EXPECT_EQ(sketch.total(), 20000);
+    for (const auto &kv : exact)
+        EXPECT_GE(sketch.estimate(kv.first), kv.second) << kv.first;
+}
+
+TEST(TopKSketchTest, FindsHeavyHitters)
+{
+    // A few heavy keys hidden among many light ones, in a counter
+    // space much smaller than the number of distinct keys
+    const unsigned k = 5;
+    TopKSketch sketch(k, 256, 4);
+    std::set<uint64_t> heavy;
+    for (uint64_t h = 0; h < k; h++)
+        heavy.insert(0xdead0000 + h);
+
+    uint64_t light = 0;
+    for (int round = 0; round < 200; round++) {
+        for (uint64_t h : heavy)
+            sketch.add(h, 5);
+        for (int i = 0; i < 50; i++)
+            sketch.add(light++);
+    }
+
+    std::vector<TopKSketch::Entry> top = sketch.top();
+    ASSERT_EQ(top.size(), k);
+    for (const auto &entry : top) {
+        EXPECT_EQ(heavy.count(entry.first), 1) << entry.first;
+        // 1000 increments each, plus at most 2N/width of collisions
+        EXPECT_GE(entry.second, 1000);
+        EXPECT_LE(entry.second, 1000 + 2 * sketch.total() / 256);
+    }
+    for (size_t i = 1; i < top.size(); i++)
+        EXPECT_GE(top[i - 1].second, top[i].second);
+}
+
+TEST(TopKSketchTest, Reset)
+{
+    TopKSketch sketch(2);
+    sketch.add(1, 10);
+    sketch.add(2, 20);
+    sketch.reset();
+
+    EXPECT_EQ(sketch.total(), 0);
+    EXPECT_EQ(sketch.estimate(1), 0);
+    EXPECT_TRUE(sketch.top().empty());
+
+    sketch.add(3, 7);
+    ASSERT_EQ(sketch.top().size(), 1);
+    EXPECT_EQ(sketch.top()[0], TopKSketch::Entry(3, 7));
+}
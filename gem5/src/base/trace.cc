@@ -36,6 +36,8 @@
 #include "base/trace.hh"
 
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -81,12 +83,34 @@ output()
 void
 setDebugLogger(Logger *logger)
 {
+    // Messages buffered by a logger are lost if gem5 leaves through
+    // exit(), e.g. on a fatal(), rather than by returning from main
+    static bool flush_at_exit = false;
+    if (!flush_at_exit) {
+        std::atexit(flushDebugLogger);
+        flush_at_exit = true;
+    }
+
     if (!logger)
         warn("Trying to set debug logger to NULL\n");
     else
         debug_logger = logger;
 }
 
+void
+flushDebugLogger()
+{
+    if (debug_logger)
+        debug_logger->flush();
+}
+
+void
+flushDebugLoggerOnAbort(bool others_idle)
+{
+    if (debug_logger)
+        debug_logger->abortFlush(others_idle);
+}
+
 void
 enable()
 {
@@ -157,4 +181,120 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     stream.flush();
 }
 
+/** Collects text written to the logger's ostream into lines */
+class BinaryLogger::LineBuf : public std::streambuf
+{
+  public:
+    LineBuf(BinaryLogger &logger) : logger(logger)
+    {
+        setp(buf, buf + sizeof(buf));
+    }
+
+  protected:
+    int_type
+    overflow(int_type c) override
+    {
+        take();
+        if (c != traits_type::eof()) {
+            char ch = traits_type::to_char_type(c);
+            append(&ch, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize
+    xsputn(const char *s, std::streamsize n) override
+    {
+        take();
+        append(s, n);
+        return n;
+    }
+
+    int
+    sync() override
+    {
+        take();
+        if (!line.empty()) {
+            logger.logMessage(MaxTick, std::string(), line);
+            line.clear();
+        }
+        return 0;
+    }
+
+  private:
+    /** Move the characters in the put area to the line */
+    void
+    take()
+    {
+        append(pbase(), pptr() - pbase());
+        setp(buf, buf + sizeof(buf));
+    }
+
+    /** Add text to the line, logging every line it completes */
+    void
+    append(const char *s, size_t n)
+    {
+        while (n) {
+            const char *nl = static_cast<const char *>(
+                std::memchr(s, '\n', n));
+            size_t len = nl ? nl - s + 1 : n;
+            line.append(s, len);
+            if (nl) {
+                logger.logMessage(MaxTick, std::string(), line);
+                line.clear();
+            }
+            s += len;
+            n -= len;
+        }
+    }
+
+    BinaryLogger &logger;
+    std::string line;
+    /** Put area, so single characters do not each call overflow() */
+    char buf[256];
+};
+
+BinaryLogger::BinaryLogger(std::ostream &stream_)
+    : trace(stream_), lineBuf(new LineBuf(*this)),
+      lineStream(new std::ostream(lineBuf.get()))
+{
+    binary = &trace;
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    lineStream->flush();
+}
+
+void
+BinaryLogger::flush()
+{
+    lineStream->flush();
+    trace.flush();
+}
+
+void
+BinaryLogger::abortFlush(bool others_idle)
+{
+    lineStream->flush();
+    trace.abortFlush(others_idle);
+}
+
+void
+BinaryLogger::redirect(std::ostream &stream_)
+{
+    lineStream->flush();
+    trace.redirect(stream_);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+                         const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    trace.log(when, name, "%s", message);
+}
+
 } // namespace Trace
@@ -36,8 +36,10 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <memory>
 #include <string>
 
+#include "base/binary_trace.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
@@ -54,6 +56,9 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Binary backend, messages are recorded unformatted if set */
+    BinaryTrace *binary = nullptr;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -63,6 +68,11 @@ class Logger
         if (!name.empty() && ignore.match(name))
             return;
 
+        if (binary) {
+            binary->log(when, name, fmt, args...);
+            return;
+        }
+
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, line.str());
@@ -86,6 +96,14 @@ class Logger
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
+    /** Write out anything the logger still buffers */
+    virtual void flush() { getOstream().flush(); }
+
+    /** Write out what can be written without waiting for other
+     *  threads, as gem5 aborts. others_idle says whether the other
+     *  simulation threads are known not to be logging */
+    virtual void abortFlush(bool others_idle) { flush(); }
+
     virtual ~Logger() { }
 };
 
@@ -106,6 +124,35 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger writing a binary trace, see base/binary_trace.hh. Text
+ *  written to its ostream is recorded one line per message */
+class BinaryLogger : public Logger
+{
+  protected:
+    class LineBuf;
+
+    BinaryTrace trace;
+    std::unique_ptr<LineBuf> lineBuf;
+    std::unique_ptr<std::ostream> lineStream;
+
+  public:
+    BinaryLogger(std::ostream &stream_);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+                    const std::string &message) override;
+
+    std::ostream &getOstream() override { return *lineStream; }
+
+    /** Write out all messages logged so far */
+    void flush() override;
+
+    void abortFlush(bool others_idle) override;
+
+    /** Continue the trace in another stream */
+    void redirect(std::ostream &stream_);
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
@@ -116,6 +163,12 @@ std::ostream &output();
 /** Delete the current global logger and assign a new one */
 void setDebugLogger(Logger *logger);
 
+/** Flush the global logger, e.g. before gem5 exits */
+void flushDebugLogger();
+
+/** Flush what the global logger can without blocking as gem5 aborts */
+void flushDebugLoggerOnAbort(bool others_idle);
+
 /** Enable/disable debug logging */
 void enable();
 void disable();
@@ -55,7 +55,17 @@ from MemObject import MemObject
 # file describes a state transition graph where each state is a
 # specific generator behaviour. Examples include idling, generating
 # linear address sequences, random sequences and replay of captured
-# traces. By describing these behaviours as states, it is straight
+# traces. A STACK_DIST state takes the same arguments as a RANDOM
+# state followed by a stack-distance histogram file (e.g. a stats
+# dump holding a StackDistProbe) and optionally the distributions to
+# use from it (default LinearHist, e.g. system.l2.probe.LogHist for
+# the log2 ones of a single probe), and generates accesses to the
+# address range with a matching reuse-distance distribution. A
+# CLOSED_LOOP state also takes the RANDOM arguments, with the period
+# used as think time, followed by a number of dependency chains; each
+# chain only issues its next request once the previous one has
+# completed, which models a core with a fixed memory-level
+# parallelism. By describing these behaviours as states, it is straight
 # forward to create very complex behaviours, simply by arranging them
 # in graphs. The graph transitions can also be annotated with
 # probabilities, effectively making it a Markov Chain.
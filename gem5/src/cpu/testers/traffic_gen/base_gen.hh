@@ -131,6 +131,17 @@ class BaseGen
      */
     virtual Tick nextPacketTick(bool elastic, Tick delay) const = 0;
 
+    /**
+     * Receive a response while this state is active. By default the
+     * response is ignored. Generators whose injection depends on
+     * completed requests return true to let the traffic generator
+     * know that nextPacketTick may have moved earlier.
+     *
+     * @param pkt the response, still owned by the caller
+     * @return true if the next packet tick should be reconsidered
+     */
+    virtual bool recvResponse(PacketPtr pkt) { return false; }
+
 };
 
 #endif
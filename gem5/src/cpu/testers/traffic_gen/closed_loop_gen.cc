@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/closed_loop_gen.hh"
+
+#include <algorithm>
+
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/TrafficGen.hh"
+
+void
+ClosedLoopGen::enter()
+{
+    // reset the counter to zero
+    dataManipulated = 0;
+
+    // forget about anything still in flight from an earlier
+    // residency and start all chains right away
+    inFlight.clear();
+    readyChains = decltype(readyChains)();
+    for (unsigned c = 0; c < numChains; ++c)
+        readyChains.emplace(curTick(), c);
+}
+
+PacketPtr
+ClosedLoopGen::getNextPacket()
+{
+    assert(!readyChains.empty());
+    const unsigned chain = readyChains.top().second;
+    readyChains.pop();
+
+    // choose if we generate a read or a write here
+    bool isRead = readPercent != 0 &&
+        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
+
+    // address of the request, rounded down to the start of the block
+    Addr addr = random_mt.random(startAddr, endAddr - 1);
+    addr -= addr % blocksize;
+
+    DPRINTF(TrafficGen, "ClosedLoopGen::getNextPacket: chain %d %c to "
+            "addr %x, size %d\n", chain, isRead ? 'r' : 'w', addr,
+            blocksize);
+
+    // add the amount of data manipulated to the total
+    dataManipulated += blocksize;
+
+    PacketPtr pkt = getPacket(addr, blocksize,
+                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+    inFlight[pkt->req] = chain;
+    return pkt;
+}
+
+Tick
+ClosedLoopGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    // Check to see if we have reached the data limit. If dataLimit is
+    // zero we do not have a data limit and therefore we will keep
+    // generating requests for the entire residency in this state.
+    if (dataLimit && dataManipulated >= dataLimit) {
+        DPRINTF(TrafficGen, "Data limit for ClosedLoopGen reached.\n");
+        return MaxTick;
+    }
+
+    // with all chains waiting for a response there is nothing to do
+    // until one arrives, the flow control is inherent in the chains
+    // so there is no need to compensate for any delay
+    if (readyChains.empty())
+        return MaxTick;
+
+    return std::max(curTick(), readyChains.top().first);
+}
+
+bool
+ClosedLoopGen::recvResponse(PacketPtr pkt)
+{
+    auto c = inFlight.find(pkt->req);
+    if (c == inFlight.end())
+        return false;
+
+    const unsigned chain = c->second;
+    inFlight.erase(c);
+
+    // the next request of the chain depends on this one
+    const Tick think = random_mt.random(minThink, maxThink);
+    readyChains.emplace(curTick() + think, chain);
+
+    DPRINTF(TrafficGen, "ClosedLoopGen: chain %d ready in %d ticks\n",
+            chain, think);
+
+    return true;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the closed-loop generator that models a number of
+ * independent dependency chains, each waiting for its previous
+ * request to complete.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_CLOSED_LOOP_GEN_HH__
+#define __CPU_TRAFFIC_GEN_CLOSED_LOOP_GEN_HH__
+
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/testers/traffic_gen/base_gen.hh"
+#include "mem/packet.hh"
+
+/**
+ * The closed-loop generator behaves like a core with a fixed amount
+ * of memory-level parallelism. It keeps a number of independent
+ * chains, and each chain has at most one request in flight: once the
+ * response comes back, the chain waits for a random think time before
+ * issuing its next, dependent, request. The number of chains thus
+ * sets the MLP, and the think time the compute between misses, which
+ * makes the injected bandwidth a function of the memory latency
+ * rather than a fixed rate. Addresses are picked at random in the
+ * range, aligned to the block size, like the random generator.
+ *
+ * When the state is entered all chains start at once. Responses to
+ * requests issued during an earlier residency are ignored. A request
+ * the traffic generator suppresses completes right away.
+ */
+class ClosedLoopGen : public BaseGen
+{
+
+  public:
+
+    /**
+     * Create a closed-loop generator. Set min_think == max_think for
+     * a fixed think time.
+     *
+     * @param _name Name to use for status and debug
+     * @param master_id MasterID set on each request
+     * @param _duration duration of this state before transitioning
+     * @param start_addr Start address
+     * @param end_addr End address
+     * @param _blocksize Size used for transactions injected
+     * @param min_think Lower limit of the random think time
+     * @param max_think Upper limit of the random think time
+     * @param read_percent Percent of transactions that are reads
+     * @param data_limit Upper limit on how much data to read/write
+     * @param num_chains Number of independent dependency chains
+     */
+    ClosedLoopGen(const std::string& _name, MasterID master_id,
+                  Tick _duration, Addr start_addr, Addr end_addr,
+                  Addr _blocksize, Tick min_think, Tick max_think,
+                  uint8_t read_percent, Addr data_limit,
+                  unsigned num_chains)
+        : BaseGen(_name, master_id, _duration),
+          startAddr(start_addr), endAddr(end_addr),
+          blocksize(_blocksize), minThink(min_think),
+          maxThink(max_think), readPercent(read_percent),
+          dataLimit(data_limit), numChains(num_chains),
+          dataManipulated(0)
+    { }
+
+    void enter();
+
+    PacketPtr getNextPacket();
+
+    Tick nextPacketTick(bool elastic, Tick delay) const;
+
+    bool recvResponse(PacketPtr pkt);
+
+  protected:
+
+    /** Start of address range */
+    const Addr startAddr;
+
+    /** End of address range */
+    const Addr endAddr;
+
+    /** Block size */
+    const Addr blocksize;
+
+    /** Think time between a response and the next request */
+    const Tick minThink;
+    const Tick maxThink;
+
+    /**
+     * Percent of generated transactions that should be reads
+     */
+    const uint8_t readPercent;
+
+    /** Maximum amount of data to manipulate */
+    const Addr dataLimit;
+
+    /** Number of independent chains, i.e. the MLP */
+    const unsigned numChains;
+
+    /**
+     * Counter to determine the amount of data
+     * manipulated. Used to determine if we should continue
+     * generating requests.
+     */
+    Addr dataManipulated;
+
+    /** A chain that may issue, and the tick it may do so */
+    typedef std::pair<Tick, unsigned> ReadyChain;
+
+    /** Chains without a request in flight, earliest first */
+    std::priority_queue<ReadyChain, std::vector<ReadyChain>,
+                        std::greater<ReadyChain> > readyChains;
+
+    /** Chain waiting for each request in flight */
+    std::unordered_map<const Request*, unsigned> inFlight;
+};
+
+#endif
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/stack_dist_gen.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/str.hh"
+#include "base/trace.hh"
+#include "debug/TrafficGen.hh"
+
+StackDistGen::StackDistGen(const std::string& _name, MasterID master_id,
+                           Tick _duration, Addr start_addr, Addr end_addr,
+                           Addr _blocksize, Tick min_period,
+                           Tick max_period, uint8_t read_percent,
+                           Addr data_limit, const std::string& hist_file,
+                           const std::string& hist_stats)
+    : BaseGen(_name, master_id, _duration),
+      startAddr(start_addr), blocksize(_blocksize),
+      numBlocks(end_addr > start_addr ?
+                std::min<Addr>((end_addr - start_addr) / _blocksize,
+                               (Addr)NotOnStack) : 0),
+      minPeriod(min_period), maxPeriod(max_period),
+      readPercent(read_percent), dataLimit(data_limit),
+      dataManipulated(0), nextSlot(0), stackSize(0)
+{
+    fatal_if(numBlocks == 0, "%s: StackDistGen footprint %#x to %#x holds "
+             "no %d byte blocks\n", _name, start_addr, end_addr, blocksize);
+    fatal_if(numBlocks > (1U << 31), "%s: StackDistGen footprint of %d "
+             "blocks is too large\n", _name, numBlocks);
+
+    parseHistogram(hist_file, hist_stats);
+
+    // leave at least as many free timestamps as there are blocks so
+    // that compaction is amortised over many accesses
+    const size_t slots = std::max<size_t>(2, ceilPow2(
+                                              2 * (uint64_t)numBlocks));
+    tree.assign(slots + 1, 0);
+    slotBlock.assign(slots, 0);
+    blockSlot.assign(numBlocks, (uint32_t)NotOnStack);
+
+    untouched.resize(numBlocks);
+    for (uint32_t i = 0; i < numBlocks; ++i)
+        untouched[i] = i;
+}
+
+/** Does s end with suffix? */
+static bool
+endsWith(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size() &&
+        s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void
+StackDistGen::parseHistogram(const std::string& hist_file,
+                             const std::string& hist_stats)
+{
+    std::ifstream infile(hist_file);
+    fatal_if(!infile.is_open(), "%s: stack-distance histogram %s could not "
+             "be opened\n", _name, hist_file);
+
+    // hist_stats selects the distributions of a stats dump by the end
+    // of their name, optionally preceded by the object holding them,
+    // e.g. LinearHist or system.l2.probe.LogHist
+    const size_t dot = hist_stats.rfind('.');
+    const std::string want_object =
+        dot == std::string::npos ? "" : hist_stats.substr(0, dot);
+    const std::string want_stat =
+        dot == std::string::npos ? hist_stats : hist_stats.substr(dot + 1);
+
+    // the object, bin kind and line format seen so far, which must not
+    // change within the file, as the same accesses would be counted
+    // more than once
+    std::string object;
+    bool seen_plain = false, seen_stats = false;
+    bool seen_linear = false, seen_log = false;
+
+    std::string line;
+    while (std::getline(infile, line)) {
+        // only use the first dump of a stats file
+        if (!buckets.empty() &&
+            line.find("End Simulation Statistics") != std::string::npos)
+            break;
+
+        std::istringstream is(line);
+        std::string key;
+        uint64_t count;
+        if (!(is >> key) || key[0] == '#' || !(is >> count) || count == 0)
+            continue;
+
+        // split the lines taken from a stats dump into the object, the
+        // stat and the bucket, and skip the stats that were not asked for
+        std::string owner, stat;
+        std::string bucket = key;
+        bool log_bins = false;
+        const size_t sep = key.rfind("::");
+        if (sep != std::string::npos) {
+            const std::string name = key.substr(0, sep);
+            const size_t name_dot = name.rfind('.');
+            owner = name_dot == std::string::npos ? "" :
+                name.substr(0, name_dot);
+            stat = name.substr(name_dot + 1);
+            bucket = key.substr(sep + 2);
+            if (!endsWith(stat, want_stat))
+                continue;
+            log_bins = endsWith(stat, "LogHist");
+        } else if (endsWith(key, ".infinity")) {
+            owner = key.substr(0, key.size() - 9);
+            stat = "infinity";
+            bucket = "inf";
+        }
+
+        if (!stat.empty()) {
+            if (!want_object.empty() && owner != want_object)
+                continue;
+            fatal_if(!object.empty() && owner != object, "%s: %s holds "
+                     "stack distances of %s and %s, select one with "
+                     "%s.%s\n", _name, hist_file, object, owner, owner,
+                     want_stat);
+            object = owner;
+            seen_stats = true;
+
+            // the dump only gives the count beyond the last bucket, so
+            // those distances cannot be reproduced
+            fatal_if(bucket == "overflows" || bucket == "underflows",
+                     "%s: %s has %d %s in %s, use a histogram that "
+                     "covers all distances\n", _name, hist_file, count,
+                     bucket, stat);
+        } else {
+            seen_plain = true;
+        }
+
+        Bucket b;
+        if (bucket == "inf" || bucket == "infinity") {
+            b.low = b.high = Infinity;
+        } else {
+            const size_t dash = bucket.find('-');
+            if (!to_number(bucket.substr(0, dash), b.low))
+                continue;
+            if (dash == std::string::npos) {
+                b.high = b.low;
+            } else if (!to_number(bucket.substr(dash + 1), b.high)) {
+                continue;
+            }
+
+            fatal_if(b.high < b.low, "%s: invalid stack-distance bucket "
+                     "%s in %s\n", _name, bucket, hist_file);
+
+            if (log_bins) {
+                fatal_if(b.high >= 63, "%s: log2 stack-distance bucket %s "
+                         "in %s is out of range\n", _name, bucket,
+                         hist_file);
+                b.low = 1ULL << b.low;
+                b.high = (2ULL << b.high) - 1;
+                seen_log = true;
+            } else if (!stat.empty()) {
+                seen_linear = true;
+            }
+        }
+        b.cumCount = count;
+        buckets.push_back(b);
+    }
+
+    fatal_if(buckets.empty(), "%s: no stack distances found in %s\n",
+             _name, hist_file);
+    fatal_if(seen_plain && seen_stats, "%s: %s mixes plain buckets with "
+             "the lines of a stats dump\n", _name, hist_file);
+    fatal_if(seen_linear && seen_log, "%s: %s stats ending in %s hold both "
+             "linear and log2 histograms of the same accesses, select "
+             "one family, e.g. LinearHist\n", _name, hist_file, want_stat);
+
+    std::sort(buckets.begin(), buckets.end(),
+              [](const Bucket& a, const Bucket& b) { return a.low < b.low; });
+
+    for (size_t i = 1; i < buckets.size(); ++i)
+        buckets[i].cumCount += buckets[i - 1].cumCount;
+
+    DPRINTF(TrafficGen, "StackDistGen: %d buckets, %d samples from %s\n",
+            buckets.size(), buckets.back().cumCount, hist_file);
+}
+
+void
+StackDistGen::enter()
+{
+    // reset the counter to zero, the stack is kept so that the
+    // footprint stays warm when the state is re-entered
+    dataManipulated = 0;
+}
+
+PacketPtr
+StackDistGen::getNextPacket()
+{
+    // choose if we generate a read or a write here
+    bool isRead = readPercent != 0 &&
+        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
+
+    const uint64_t distance = sampleDistance();
+    const Addr addr = startAddr + (Addr)access(distance) * blocksize;
+
+    DPRINTF(TrafficGen, "StackDistGen::getNextPacket: %c to addr %x, "
+            "size %d, distance %d\n", isRead ? 'r' : 'w', addr, blocksize,
+            distance);
+
+    // add the amount of data manipulated to the total
+    dataManipulated += blocksize;
+
+    // create a new request packet
+    return getPacket(addr, blocksize,
+                     isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+}
+
+Tick
+StackDistGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    // Check to see if we have reached the data limit. If dataLimit is
+    // zero we do not have a data limit and therefore we will keep
+    // generating requests for the entire residency in this state.
+    if (dataLimit && dataManipulated >= dataLimit) {
+        DPRINTF(TrafficGen, "Data limit for StackDistGen reached.\n");
+        // No more requests. Return MaxTick.
+        return MaxTick;
+    } else {
+        // return the time when the next request should take place
+        Tick wait = random_mt.random(minPeriod, maxPeriod);
+
+        // compensate for the delay experienced to not be elastic
+        if (!elastic) {
+            if (wait < delay)
+                wait = 0;
+            else
+                wait -= delay;
+        }
+
+        return curTick() + wait;
+    }
+}
+
+uint64_t
+StackDistGen::sampleDistance() const
+{
+    const uint64_t r =
+        random_mt.random<uint64_t>(0, buckets.back().cumCount - 1);
+    const auto b = std::upper_bound(buckets.begin(), buckets.end(), r,
+                                    [](uint64_t v, const Bucket& b) {
+                                        return v < b.cumCount;
+                                    });
+    assert(b != buckets.end());
+
+    if (b->low == Infinity || b->low == b->high)
+        return b->low;
+    return random_mt.random<uint64_t>(b->low, b->high);
+}
+
+uint32_t
+StackDistGen::access(uint64_t distance)
+{
+    uint32_t block;
+
+    if (distance >= stackSize && !untouched.empty()) {
+        // first touch of a block, picked at random from the part of
+        // the footprint not yet used
+        const size_t i = random_mt.random<size_t>(0, untouched.size() - 1);
+        block = untouched[i];
+        untouched[i] = untouched.back();
+        untouched.pop_back();
+    } else {
+        // with the whole footprint on the stack, a distance beyond
+        // its depth touches the least recently used block
+        const uint64_t depth = std::min<uint64_t>(distance, stackSize - 1);
+        const size_t pos = treeFind(stackSize - depth);
+        block = slotBlock[pos - 1];
+        assert(blockSlot[block] == pos - 1);
+        blockSlot[block] = NotOnStack;
+        treeAdd(pos, -1);
+        --stackSize;
+    }
+
+    push(block);
+    return block;
+}
+
+void
+StackDistGen::push(uint32_t block)
+{
+    if (nextSlot == slotBlock.size())
+        compact();
+
+    slotBlock[nextSlot] = block;
+    blockSlot[block] = nextSlot;
+    treeAdd(nextSlot + 1, 1);
+    ++nextSlot;
+    ++stackSize;
+}
+
+void
+StackDistGen::compact()
+{
+    // move the live entries, oldest first, to the lowest timestamps
+    uint32_t live = 0;
+    for (uint32_t s = 0; s < nextSlot; ++s) {
+        const uint32_t block = slotBlock[s];
+        if (blockSlot[block] == s) {
+            slotBlock[live] = block;
+            blockSlot[block] = live;
+            ++live;
+        }
+    }
+    assert(live == stackSize);
+    nextSlot = live;
+
+    // rebuild the tree in linear time
+    std::fill(tree.begin(), tree.end(), 0);
+    const size_t size = tree.size() - 1;
+    for (size_t i = 1; i <= live; ++i)
+        tree[i] = 1;
+    for (size_t i = 1; i <= size; ++i) {
+        const size_t parent = i + (i & -i);
+        if (parent <= size)
+            tree[parent] += tree[i];
+    }
+}
+
+void
+StackDistGen::treeAdd(size_t pos, int delta)
+{
+    const size_t size = tree.size() - 1;
+    for (; pos <= size; pos += pos & -pos)
+        tree[pos] += delta;
+}
+
+size_t
+StackDistGen::treeFind(uint64_t rank) const
+{
+    // the tree size is a power of two, so walk down from the top
+    const size_t size = tree.size() - 1;
+    size_t pos = 0;
+    for (size_t step = size; step; step >>= 1) {
+        if (pos + step <= size && tree[pos + step] < rank) {
+            pos += step;
+            rank -= tree[pos];
+        }
+    }
+    return pos + 1;
+}
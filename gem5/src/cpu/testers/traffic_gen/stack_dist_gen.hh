@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the stack-distance generator that reproduces the
+ * reuse behaviour captured by a stack-distance histogram.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_STACK_DIST_GEN_HH__
+#define __CPU_TRAFFIC_GEN_STACK_DIST_GEN_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/testers/traffic_gen/base_gen.hh"
+#include "mem/packet.hh"
+
+/**
+ * The stack-distance generator emits a stream of block-aligned
+ * addresses whose reuse (LRU stack) distance distribution matches a
+ * histogram, e.g. one captured by the StackDistProbe on a real
+ * workload. The addresses are drawn from a footprint defined by the
+ * address range, and the read/write mix is controlled by the read
+ * percentage just like the random generator.
+ *
+ * The histogram file holds one bucket per line as "<bucket> <count>",
+ * where the bucket is a single distance, an inclusive range "lo-hi",
+ * or "inf" for accesses with infinite distance (first touches). Lines
+ * copied from a stats dump are accepted as is: the stat name before
+ * "::" is dropped, the StackDistProbe ".infinity" scalar maps to the
+ * infinite bucket, buckets of the log histograms (stat names
+ * containing "LogHist") are interpreted as powers of two, and
+ * anything else (samples, mean, etc) is ignored. Only the first
+ * dump in a stats file is used.
+ *
+ * The LRU stack is kept as a Fenwick tree over access timestamps, so
+ * finding the block at a given depth and moving it to the top are
+ * both logarithmic in the footprint.
+ */
+class StackDistGen : public BaseGen
+{
+
+  public:
+
+    /**
+     * Create a stack-distance driven address sequence
+     * generator. Set min_period == max_period for a fixed
+     * inter-transaction time.
+     *
+     * @param _name Name to use for status and debug
+     * @param master_id MasterID set on each request
+     * @param _duration duration of this state before transitioning
+     * @param start_addr Start address of the footprint
+     * @param end_addr End address of the footprint
+     * @param _blocksize Size used for transactions injected
+     * @param min_period Lower limit of random inter-transaction time
+     * @param max_period Upper limit of random inter-transaction time
+     * @param read_percent Percent of transactions that are reads
+     * @param data_limit Upper limit on how much data to read/write
+     * @param hist_file File holding the stack-distance histogram
+     * @param hist_stats Distributions to use from a stats dump, as the
+     *                   end of their name, optionally preceded by the
+     *                   object, e.g. LinearHist
+     */
+    StackDistGen(const std::string& _name, MasterID master_id,
+                 Tick _duration, Addr start_addr, Addr end_addr,
+                 Addr _blocksize, Tick min_period, Tick max_period,
+                 uint8_t read_percent, Addr data_limit,
+                 const std::string& hist_file,
+                 const std::string& hist_stats);
+
+    void enter();
+
+    PacketPtr getNextPacket();
+
+    Tick nextPacketTick(bool elastic, Tick delay) const;
+
+  protected:
+
+    /** Marker for the bucket of first touches */
+    static const uint64_t Infinity = (uint64_t)-1;
+
+    /** Marker for a block that is not on the stack */
+    static const uint32_t NotOnStack = (uint32_t)-1;
+
+    /** A histogram bucket covering the distances [low, high] */
+    struct Bucket
+    {
+        uint64_t low;
+        uint64_t high;
+        /** Sum of the counts of this and all preceding buckets */
+        uint64_t cumCount;
+    };
+
+    /**
+     * Read the histogram file and build the cumulative distribution
+     * used to sample distances. Of a stats dump, only the first dump
+     * of the distributions selected by hist_stats and the infinity
+     * count of the same object are used.
+     */
+    void parseHistogram(const std::string& hist_file,
+                        const std::string& hist_stats);
+
+    /** Draw a distance from the histogram. */
+    uint64_t sampleDistance() const;
+
+    /**
+     * Access the block at the given stack depth, or a block not yet
+     * on the stack for an infinite (or too large) distance, and move
+     * it to the top of the stack.
+     *
+     * @return index of the block in the footprint
+     */
+    uint32_t access(uint64_t distance);
+
+    /** Place a block at the top of the stack. */
+    void push(uint32_t block);
+
+    /** Renumber the live timestamps once the tree is exhausted. */
+    void compact();
+
+    /** Add delta at (1-based) position pos of the Fenwick tree. */
+    void treeAdd(size_t pos, int delta);
+
+    /** Find the (1-based) position holding the rank-th live entry. */
+    size_t treeFind(uint64_t rank) const;
+
+    /** Start of the footprint */
+    const Addr startAddr;
+
+    /** Block size */
+    const Addr blocksize;
+
+    /** Number of blocks in the footprint */
+    const uint32_t numBlocks;
+
+    /** Request generation period */
+    const Tick minPeriod;
+    const Tick maxPeriod;
+
+    /**
+     * Percent of generated transactions that should be reads
+     */
+    const uint8_t readPercent;
+
+    /** Maximum amount of data to manipulate */
+    const Addr dataLimit;
+
+    /**
+     * Counter to determine the amount of data
+     * manipulated. Used to determine if we should continue
+     * generating requests.
+     */
+    Addr dataManipulated;
+
+    /** Cumulative histogram, sorted by distance */
+    std::vector<Bucket> buckets;
+
+    /** Fenwick tree over timestamps marking the live stack entries */
+    std::vector<uint32_t> tree;
+
+    /** Block occupying each timestamp */
+    std::vector<uint32_t> slotBlock;
+
+    /** Timestamp of each block, or NotOnStack */
+    std::vector<uint32_t> blockSlot;
+
+    /** Blocks not yet touched, consumed in random order */
+    std::vector<uint32_t> untouched;
+
+    /** Next free timestamp */
+    uint32_t nextSlot;
+
+    /** Number of blocks on the stack */
+    uint32_t stackSize;
+};
+
+#endif
@@ -213,6 +213,10 @@ TrafficGen::update()
                 warn("%s suppressed %d packets with non-memory addresses\n",
                      name(), numSuppressed);
 
+            // a generator waiting for the response, e.g. a closed-loop
+            // chain, carries on as if the access completed right away
+            states[currState]->recvResponse(pkt);
+
             delete pkt->req;
             delete pkt;
             pkt = nullptr;
@@ -309,7 +313,8 @@ TrafficGen::parseConfig()
                     states[id] = new ExitGen(name(), masterID, duration);
                     DPRINTF(TrafficGen, "State: %d ExitGen\n", id);
                 } else if (mode == "LINEAR" || mode == "RANDOM" ||
-                           mode == "DRAM"   || mode == "DRAM_ROTATE") {
+                           mode == "DRAM"   || mode == "DRAM_ROTATE" ||
+                           mode == "STACK_DIST" || mode == "CLOSED_LOOP") {
                     uint32_t read_percent;
                     Addr start_addr;
                     Addr end_addr;
@@ -352,6 +357,46 @@ TrafficGen::parseConfig()
                                                    min_period, max_period,
                                                    read_percent, data_limit);
                         DPRINTF(TrafficGen, "State: %d RandomGen\n", id);
+                    } else if (mode == "STACK_DIST") {
+                        string hist_file;
+                        string hist_stats;
+
+                        is >> hist_file;
+                        hist_file = resolveFile(hist_file);
+
+                        // the linear histograms of a StackDistProbe
+                        // unless told otherwise
+                        if (!(is >> hist_stats))
+                            hist_stats = "LinearHist";
+
+                        states[id] = new StackDistGen(name(), masterID,
+                                                      duration, start_addr,
+                                                      end_addr, blocksize,
+                                                      min_period, max_period,
+                                                      read_percent,
+                                                      data_limit, hist_file,
+                                                      hist_stats);
+                        DPRINTF(TrafficGen, "State: %d StackDistGen\n", id);
+                    } else if (mode == "CLOSED_LOOP") {
+                        // the period is the think time of each chain
+                        unsigned int num_chains;
+
+                        is >> num_chains;
+
+                        if (num_chains == 0)
+                            fatal("%s closed-loop state needs at least one "
+                                  "chain\n", name());
+
+                        states[id] = new ClosedLoopGen(name(), masterID,
+                                                       duration, start_addr,
+                                                       end_addr, blocksize,
+                                                       min_period,
+                                                       max_period,
+                                                       read_percent,
+                                                       data_limit,
+                                                       num_chains);
+                        DPRINTF(TrafficGen, "State: %d ClosedLoopGen\n",
+                                id);
                     } else if (mode == "DRAM" || mode == "DRAM_ROTATE") {
                         // stride size (bytes) of the request for achieving
                         // required hit length
@@ -544,6 +589,34 @@ TrafficGen::recvReqRetry()
     }
 }
 
+void
+TrafficGen::recvTimingResp(PacketPtr pkt)
+{
+    const Tick latency = curTick() - pkt->req->time();
+    numResponses++;
+    totalRespLatency += latency;
+    respLatencyPct.sample(latency);
+
+    // a closed-loop state may be able to issue again, so pull the
+    // update forward unless we are stalled on a retry or draining
+    if (states[currState]->recvResponse(pkt) && retryPkt == NULL &&
+        drainState() == DrainState::Running) {
+        Tick tick = states[currState]->nextPacketTick(elasticReq, 0);
+        if (tick < nextPacketTick || !updateEvent.scheduled()) {
+            nextPacketTick = tick;
+            Tick nextEventTick = std::max(curTick(),
+                                          std::min(nextPacketTick,
+                                                   nextTransitionTick));
+            DPRINTF(TrafficGen, "Response moves next event to %lld\n",
+                    nextEventTick);
+            reschedule(updateEvent, nextEventTick, true);
+        }
+    }
+
+    delete pkt->req;
+    delete pkt;
+}
+
 void
 TrafficGen::noProgress()
 {
@@ -570,13 +643,24 @@ TrafficGen::regStats()
     retryTicks
         .name(name() + ".retryTicks")
         .desc("Time spent waiting due to back-pressure (ticks)");
-}
-
-bool
-TrafficGen::TrafficGenPort::recvTimingResp(PacketPtr pkt)
-{
-    delete pkt->req;
-    delete pkt;
 
-    return true;
+    numResponses
+        .name(name() + ".numResponses")
+        .desc("Number of responses received");
+
+    totalRespLatency
+        .name(name() + ".totalRespLatency")
+        .desc("Total request-response latency (ticks)");
+
+    avgRespLatency
+        .name(name() + ".avgRespLatency")
+        .desc("Average request-response latency (ticks)")
+        .precision(2);
+    avgRespLatency = totalRespLatency / numResponses;
+
+    respLatencyPct
+        .init()
+        .name(name() + ".respLatencyPct")
+        .desc("Request-response latency percentiles (ticks)")
+        .flags(Stats::nozero);
 }
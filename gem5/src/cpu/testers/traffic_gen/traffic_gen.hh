@@ -46,12 +46,14 @@
 
 #include "base/statistics.hh"
 #include "cpu/testers/traffic_gen/base_gen.hh"
+#include "cpu/testers/traffic_gen/closed_loop_gen.hh"
 #include "cpu/testers/traffic_gen/dram_gen.hh"
 #include "cpu/testers/traffic_gen/dram_rot_gen.hh"
 #include "cpu/testers/traffic_gen/exit_gen.hh"
 #include "cpu/testers/traffic_gen/idle_gen.hh"
 #include "cpu/testers/traffic_gen/linear_gen.hh"
 #include "cpu/testers/traffic_gen/random_gen.hh"
+#include "cpu/testers/traffic_gen/stack_dist_gen.hh"
 #include "cpu/testers/traffic_gen/trace_gen.hh"
 #include "mem/mem_object.hh"
 #include "mem/qport.hh"
@@ -117,6 +119,12 @@ class TrafficGen : public MemObject
      */
     void recvReqRetry();
 
+    /**
+     * Account for a response and pass it on to the active state,
+     * waking up the generator if the state is now ready earlier.
+     */
+    void recvTimingResp(PacketPtr pkt);
+
     /**
      * Method to inform the user we have made no progress.
      */
@@ -190,7 +198,11 @@ class TrafficGen : public MemObject
 
         void recvReqRetry() { trafficGen.recvReqRetry(); }
 
-        bool recvTimingResp(PacketPtr pkt);
+        bool recvTimingResp(PacketPtr pkt)
+        {
+            trafficGen.recvTimingResp(pkt);
+            return true;
+        }
 
         void recvTimingSnoopReq(PacketPtr pkt) { }
 
@@ -227,6 +239,14 @@ class TrafficGen : public MemObject
     /** Count the time incurred from back-pressure. */
     Stats::Scalar retryTicks;
 
+    /** Count the number of responses received. */
+    Stats::Scalar numResponses;
+
+    /** Request-response latency, summed, averaged and percentiles. */
+    Stats::Scalar totalRespLatency;
+    Stats::Formula avgRespLatency;
+    Stats::Percentiles respLatencyPct;
+
   public:
 
     TrafficGen(const TrafficGenParams* p);
@@ -113,7 +113,8 @@ ThreadState::initMemProxies(ThreadContext *tc)
         // itself is created in the base cpu constructor and the
         // getDataPort is a virtual function
         physProxy = new PortProxy(baseCpu->getDataPort(),
-                                  baseCpu->cacheLineSize());
+                                  baseCpu->cacheLineSize(),
+                                  baseCpu->system);
 
         assert(virtProxy == NULL);
         virtProxy = new FSTranslatingPortProxy(tc);
@@ -100,3 +100,10 @@ class CommMonitor(MemObject):
     read_addr_mask = Param.Addr(MaxAddr, "Address mask for read address")
     write_addr_mask = Param.Addr(MaxAddr, "Address mask for write address")
     disable_addr_dists = Param.Bool(True, "Disable address distributions")
+
+    # export a summary of every sample period (bandwidth, latency
+    # percentiles, read/write mix and an address heat map) to a ring
+    # buffer in POSIX shared memory, see util/monitor_view.py
+    export_shm = Param.String("", "Shared memory segment to export " \
+                                  "windows to, disabled if empty")
+    export_slots = Param.Unsigned(256, "Windows kept in the export ring")
@@ -125,6 +125,13 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize('8MB', "Maximum capacity of snoop filter")
 
+    # Group the tracked lines by region (e.g. 1kB to 4kB, at most 64
+    # lines), with one entry per region rather than per line. Snoops
+    # still go to the holders of the line only. Zero keeps the per-line
+    # entries.
+    region_size = Param.Unsigned(0, "Tracking granularity in bytes, "
+                                 "0 for per-line tracking")
+
 # We use a coherent crossbar to connect multiple masters to the L2
 # caches. Normally this crossbar would be part of the cache itself.
 class L2XBar(CoherentXBar):
@@ -1667,6 +1667,13 @@ BaseCache::regStats()
         overallMissLatency.subname(i, system->getMasterName(i));
     }
 
+    demandMissLatencyPct
+        .init()
+        .name(name() + ".demand_miss_latency_pct")
+        .desc("percentiles of the demand miss latency (ticks)")
+        .flags(nozero)
+        ;
+
     // access formulas
     for (int access_idx = 0; access_idx < MemCmd::NUM_MEM_CMDS; ++access_idx) {
         MemCmd cmd(access_idx);
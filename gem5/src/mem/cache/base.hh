@@ -862,6 +862,8 @@ class BaseCache : public MemObject
     Stats::Formula demandMissLatency;
     /** Total number of cycles spent waiting for all misses. */
     Stats::Formula overallMissLatency;
+    /** Percentiles of the latency of demand misses. */
+    Stats::Percentiles demandMissLatencyPct;
 
     /** The number of accesses per command and thread. */
     Stats::Formula accesses[MemCmd::NUM_MEM_CMDS];
@@ -1114,6 +1116,25 @@ class BaseCache : public MemObject
         hits[pkt->cmdToIndex()][pkt->req->masterId()]++;
 
     }
+    void incMissLatency(PacketPtr pkt, Tick latency)
+    {
+        assert(pkt->req->masterId() < system->maxMasters());
+        missLatency[pkt->cmdToIndex()][pkt->req->masterId()] += latency;
+
+        // the same commands as in demandMissLatency
+        switch (pkt->cmdToIndex()) {
+          case MemCmd::ReadReq:
+          case MemCmd::WriteReq:
+          case MemCmd::WriteLineReq:
+          case MemCmd::ReadExReq:
+          case MemCmd::ReadCleanReq:
+          case MemCmd::ReadSharedReq:
+            demandMissLatencyPct.sample(latency);
+            break;
+          default:
+            break;
+        }
+    }
 
     /**
      * Cache block visitor that writes back dirty cache blocks using
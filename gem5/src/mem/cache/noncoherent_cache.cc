@@ -276,9 +276,7 @@ NoncoherentCache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt,
             completion_time += clockEdge(responseLatency) +
                 (transfer_offset ? pkt->payloadDelay : 0);
 
-            assert(tgt_pkt->req->masterId() < system->maxMasters());
-            missLatency[tgt_pkt->cmdToIndex()][tgt_pkt->req->masterId()] +=
-                completion_time - target.recvTime;
+            incMissLatency(tgt_pkt, completion_time - target.recvTime);
 
             tgt_pkt->makeTimingResponse();
             if (pkt->isError())
@@ -33,6 +33,7 @@
 
 #include <memory>
 
+#include "base/types.hh"
 #include "params/BaseReplacementPolicy.hh"
 #include "sim/sim_object.hh"
 
@@ -108,6 +109,20 @@ class BaseReplacementPolicy : public SimObject
     virtual void reset(const std::shared_ptr<ReplacementData>&
                                                 replacement_data) const = 0;
 
+    /**
+     * Reset replacement data as if its holder had last been accessed at
+     * the given tick. Used when restoring cache contents, defaults to a
+     * plain reset for policies that do not order entries by time.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param tick Tick of the last access to the holder.
+     */
+    virtual void restore(const std::shared_ptr<ReplacementData>&
+                         replacement_data, Tick tick) const
+    {
+        reset(replacement_data);
+    }
+
     /**
      * Find replacement victim among candidates.
      *
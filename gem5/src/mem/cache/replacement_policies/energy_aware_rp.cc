@@ -143,6 +143,18 @@ EnergyAwareRP::reset(const std::shared_ptr<ReplacementData>& replacement_data) c
     repl_data->energyCost = calculateEnergyCost(repl_data);
 }
 
+void
+EnergyAwareRP::restore(const std::shared_ptr<ReplacementData>& replacement_data,
+                       Tick tick) const
+{
+    reset(replacement_data);
+
+    std::shared_ptr<EnergyAwareReplData> repl_data =
+        std::static_pointer_cast<EnergyAwareReplData>(replacement_data);
+    repl_data->lastTouchTick = tick;
+    repl_data->energyCost = calculateEnergyCost(repl_data);
+}
+
 ReplaceableEntry*
 EnergyAwareRP::getVictim(const ReplacementCandidates& candidates) const
 {
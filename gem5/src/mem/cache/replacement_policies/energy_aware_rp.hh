@@ -162,6 +162,16 @@ class EnergyAwareRP : public BaseReplacementPolicy
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
 
+    /**
+     * Restore replacement data. Resets it with the given tick as its
+     * last touch.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param tick Tick of the last access to the entry.
+     */
+    void restore(const std::shared_ptr<ReplacementData>& replacement_data,
+                 Tick tick) const override;
+
     /**
      * Find replacement victim using energy-aware cost function.
      * Selects the block with the highest energy cost (most beneficial to evict).
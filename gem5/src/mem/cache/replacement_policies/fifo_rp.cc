@@ -63,6 +63,15 @@ FIFORP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         replacement_data)->tickInserted = curTick();
 }
 
+void
+FIFORP::restore(const std::shared_ptr<ReplacementData>& replacement_data,
+                Tick tick) const
+{
+    // Set insertion tick
+    std::static_pointer_cast<FIFOReplData>(
+        replacement_data)->tickInserted = tick;
+}
+
 ReplaceableEntry*
 FIFORP::getVictim(const ReplacementCandidates& candidates) const
 {
@@ -99,6 +99,15 @@ class FIFORP : public BaseReplacementPolicy
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
 
+    /**
+     * Restore replacement data. Sets its insertion tick as the given tick.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param tick Tick of the last access to the entry.
+     */
+    void restore(const std::shared_ptr<ReplacementData>& replacement_data,
+                 Tick tick) const override;
+
     /**
      * Find replacement victim using insertion timestamps.
      *
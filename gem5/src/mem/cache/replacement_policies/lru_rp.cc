@@ -65,6 +65,15 @@ LRURP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         replacement_data)->lastTouchTick = curTick();
 }
 
+void
+LRURP::restore(const std::shared_ptr<ReplacementData>& replacement_data,
+               Tick tick) const
+{
+    // Set last touch tick
+    std::static_pointer_cast<LRUReplData>(
+        replacement_data)->lastTouchTick = tick;
+}
+
 ReplaceableEntry*
 LRURP::getVictim(const ReplacementCandidates& candidates) const
 {
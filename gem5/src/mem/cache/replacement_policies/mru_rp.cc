@@ -65,6 +65,15 @@ MRURP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         replacement_data)->lastTouchTick = curTick();
 }
 
+void
+MRURP::restore(const std::shared_ptr<ReplacementData>& replacement_data,
+               Tick tick) const
+{
+    // Set last touch tick
+    std::static_pointer_cast<MRUReplData>(
+        replacement_data)->lastTouchTick = tick;
+}
+
 ReplaceableEntry*
 MRURP::getVictim(const ReplacementCandidates& candidates) const
 {
@@ -55,7 +55,10 @@ CommMonitor::CommMonitor(Params* params)
       samplePeriodicEvent([this]{ samplePeriodic(); }, name()),
       samplePeriodTicks(params->sample_period),
       samplePeriod(params->sample_period / SimClock::Float::s),
-      stats(params)
+      stats(params),
+      exporter(params->export_shm.empty() ? nullptr :
+               new MonitorExport(params->export_shm, params->export_slots)),
+      trackLatency(!params->disable_latency_hists || exporter)
 {
     DPRINTF(CommMonitor,
             "Created monitor %s with sample period %d ticks (%f ms)\n",
@@ -193,8 +196,10 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingReadReqs;
         }
 
-        if (!disableLatencyHists)
+        if (!disableLatencyHists) {
             readLatencyHist.sample(latency);
+            readLatencyPct.sample(latency);
+        }
 
         // Update the bandwidth stats based on responses for reads
         if (!disableBandwidthHists) {
@@ -209,8 +214,10 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingWriteReqs;
         }
 
-        if (!disableLatencyHists)
+        if (!disableLatencyHists) {
             writeLatencyHist.sample(latency);
+            writeLatencyPct.sample(latency);
+        }
     }
 }
 
@@ -228,6 +235,14 @@ CommMonitor::recvAtomic(PacketPtr pkt)
     if (expects_response)
         stats.updateRespStats(req_pkt_info, delay, true);
 
+    const MemCmd &cmd = req_pkt_info.cmd;
+    if (exporter && (cmd.isRead() || cmd.isWrite())) {
+        exporter->request(cmd.isRead(), req_pkt_info.addr,
+                          req_pkt_info.size);
+        if (expects_response)
+            exporter->response(cmd.isRead(), delay, req_pkt_info.size);
+    }
+
     assert(pkt->isResponse());
     ProbePoints::PacketInfo resp_pkt_info(pkt);
     ppPktResp->notify(resp_pkt_info);
@@ -257,7 +272,7 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     // would see a request which needs a response, but this response
     // would not come back from the memory. Therefore we additionally
     // have to check the cacheResponding flag
-    if (expects_response && !stats.disableLatencyHists) {
+    if (expects_response && trackLatency) {
         pkt->pushSenderState(new CommMonitorSenderState(curTick()));
     }
 
@@ -265,7 +280,7 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     bool successful = masterPort.sendTimingReq(pkt);
 
     // If not successful, restore the sender state
-    if (!successful && expects_response && !stats.disableLatencyHists) {
+    if (!successful && expects_response && trackLatency) {
         delete pkt->popSenderState();
     }
 
@@ -277,6 +292,9 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
         DPRINTF(CommMonitor, "Forwarded %s request\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ? "write" : "non read/write");
         stats.updateReqStats(pkt_info, false, expects_response);
+        if (exporter && (pkt_info.cmd.isRead() || pkt_info.cmd.isWrite()))
+            exporter->request(pkt_info.cmd.isRead(), pkt_info.addr,
+                              pkt_info.size);
     }
     return successful;
 }
@@ -295,7 +313,7 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
     CommMonitorSenderState* received_state =
         dynamic_cast<CommMonitorSenderState*>(pkt->senderState);
 
-    if (!stats.disableLatencyHists) {
+    if (trackLatency) {
         // Restore initial sender state
         if (received_state == NULL)
             panic("Monitor got a response without monitor sender state\n");
@@ -307,7 +325,7 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
     // Attempt to send the packet
     bool successful = slavePort.sendTimingResp(pkt);
 
-    if (!stats.disableLatencyHists) {
+    if (trackLatency) {
         // If packet successfully send, sample value of latency,
         // afterwards delete sender state, otherwise restore state
         if (successful) {
@@ -326,6 +344,9 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
         DPRINTF(CommMonitor, "Received %s response\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ?  "write" : "non read/write");
         stats.updateRespStats(pkt_info, latency, false);
+        if (exporter && (pkt_info.cmd.isRead() || pkt_info.cmd.isWrite()))
+            exporter->response(pkt_info.cmd.isRead(), latency,
+                               pkt_info.size);
     }
     return successful;
 }
@@ -450,6 +471,18 @@ CommMonitor::regStats()
         .desc("Write request-response latency")
         .flags(stats.disableLatencyHists ? nozero : pdf);
 
+    stats.readLatencyPct
+        .init()
+        .name(name() + ".readLatencyPct")
+        .desc("Read request-response latency percentiles")
+        .flags(nozero);
+
+    stats.writeLatencyPct
+        .init()
+        .name(name() + ".writeLatencyPct")
+        .desc("Write request-response latency percentiles")
+        .flags(nozero);
+
     stats.ittReadRead
         .init(1, params()->itt_max_bin, params()->itt_max_bin /
               params()->itt_bins)
@@ -536,6 +569,9 @@ CommMonitor::samplePeriodic()
         }
     }
 
+    if (exporter)
+        exporter->endWindow(curTick() - samplePeriodTicks, curTick());
+
     // reset the sampled values
     stats.readTrans = 0;
     stats.writeTrans = 0;
@@ -549,5 +585,19 @@ CommMonitor::samplePeriodic()
 void
 CommMonitor::startup()
 {
+    if (exporter) {
+        // spread the heat map over the ranges served behind the monitor
+        AddrRangeList ranges = masterPort.getAddrRanges();
+        if (!ranges.empty()) {
+            Addr start = MaxAddr;
+            Addr end = 0;
+            for (const auto &r : ranges) {
+                start = std::min(start, r.start());
+                end = std::max(end, r.end());
+            }
+            exporter->setHeatRange(start, end);
+        }
+    }
+
     schedule(samplePeriodicEvent, curTick() + samplePeriodTicks);
 }
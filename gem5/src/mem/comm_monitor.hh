@@ -45,8 +45,11 @@
 #ifndef __MEM_COMM_MONITOR_HH__
 #define __MEM_COMM_MONITOR_HH__
 
+#include <memory>
+
 #include "base/statistics.hh"
 #include "mem/mem_object.hh"
+#include "mem/monitor_export.hh"
 #include "params/CommMonitor.hh"
 #include "sim/probe/mem.hh"
 
@@ -312,6 +315,12 @@ class CommMonitor : public MemObject
         /** Histogram of write request-to-response latencies */
         Stats::Histogram writeLatencyHist;
 
+        /** Percentiles of read request-to-response latencies */
+        Stats::Percentiles readLatencyPct;
+
+        /** Percentiles of write request-to-response latencies */
+        Stats::Percentiles writeLatencyPct;
+
         /** Disable flag for ITT distributions. */
         bool disableITTDists;
 
@@ -427,6 +436,12 @@ class CommMonitor : public MemObject
     /** Instantiate stats */
     MonitorStats stats;
 
+    /** Per sample period export to shared memory, if enabled */
+    std::unique_ptr<MonitorExport> exporter;
+
+    /** Whether request to response latencies are measured */
+    const bool trackLatency;
+
   protected: // Probe points
     /**
      * @{
@@ -1269,6 +1269,7 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
 
         // Update latency stats
         totMemAccLat += dram_pkt->readyTime - dram_pkt->entryTime;
+        memAccLatPct.sample(dram_pkt->readyTime - dram_pkt->entryTime);
         totBusLat += tBURST;
         totQLat += cmd_at - dram_pkt->entryTime;
     } else {
@@ -2478,6 +2479,12 @@ DRAMCtrl::regStats()
 
     avgMemAccLat = totMemAccLat / (readBursts - servicedByWrQ);
 
+    memAccLatPct
+        .init()
+        .name(name() + ".memAccLatPct")
+        .desc("Percentiles of the memory access latency per DRAM burst "
+              "(ticks)");
+
     numRdRetry
         .name(name() + ".numRdRetry")
         .desc("Number of times read queue was full causing retry");
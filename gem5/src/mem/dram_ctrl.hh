@@ -1043,6 +1043,9 @@ class DRAMCtrl : public AbstractMemory
     Stats::Formula avgBusLat;
     Stats::Formula avgMemAccLat;
 
+    // Distribution of the memory access latency of read bursts
+    Stats::Percentiles memAccLatPct;
+
     // Average bandwidth
     Stats::Formula avgRdBW;
     Stats::Formula avgWrBW;
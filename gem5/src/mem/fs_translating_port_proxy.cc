@@ -56,7 +56,8 @@
 
 FSTranslatingPortProxy::FSTranslatingPortProxy(ThreadContext *tc)
     : PortProxy(tc->getCpuPtr()->getDataPort(),
-                tc->getSystemPtr()->cacheLineSize()), _tc(tc)
+                tc->getSystemPtr()->cacheLineSize(), tc->getSystemPtr()),
+      _tc(tc)
 {
 }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/monitor_export.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "sim/core.hh"
+
+const double MonitorExport::Quantiles[NumQuantiles] =
+    { 0.5, 0.9, 0.99, 0.999 };
+
+MonitorExport::MonitorExport(const std::string &shm_name,
+                             unsigned num_slots)
+    : name(shm_name[0] == '/' ? shm_name : "/" + shm_name),
+      size(HeaderSize + num_slots * sizeof(Window)),
+      header(nullptr), slots(nullptr), numSlots(num_slots),
+      heatStart(0), heatEnd(0), heatSlice(0),
+      readReqs(0), writeReqs(0), readBytes(0), writeBytes(0)
+{
+    static_assert(sizeof(Header) <= HeaderSize, "Header too large");
+    static_assert(sizeof(Window) % sizeof(uint64_t) == 0,
+                  "Window layout has padding");
+    fatal_if(num_slots == 0, "Monitor export needs at least one slot\n");
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    fatal_if(fd < 0, "Could not open shared memory %s: %s\n",
+             name, strerror(errno));
+    fatal_if(ftruncate(fd, size) != 0,
+             "Could not size shared memory %s: %s\n", name, strerror(errno));
+
+    void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    close(fd);
+    fatal_if(base == MAP_FAILED, "Could not map shared memory %s: %s\n",
+             name, strerror(errno));
+    std::memset(base, 0, size);
+
+    header = static_cast<Header *>(base);
+    slots = reinterpret_cast<Window *>(static_cast<char *>(base) +
+                                       HeaderSize);
+
+    std::memcpy(header->magic, "gem5mon", 8);
+    header->version = Version;
+    header->slotSize = sizeof(Window);
+    header->numSlots = numSlots;
+    header->heatBins = HeatBins;
+    header->ticksPerSecond = SimClock::Frequency;
+    header->windows.store(0, std::memory_order_release);
+
+    std::memset(heat, 0, sizeof(heat));
+}
+
+MonitorExport::~MonitorExport()
+{
+    if (header)
+        munmap(header, size);
+}
+
+void
+MonitorExport::setHeatRange(Addr start, Addr end)
+{
+    heatStart = start;
+    heatEnd = end;
+    heatSlice = (end - start) / HeatBins + 1;
+    header->heatStart = start;
+    header->heatEnd = end;
+}
+
+void
+MonitorExport::endWindow(Tick start, Tick end)
+{
+    uint64_t index = header->windows.load(std::memory_order_relaxed);
+    Window &w = slots[index % numSlots];
+
+    uint64_t seq = w.seq.load(std::memory_order_relaxed);
+    w.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    double seconds = (end - start) / SimClock::Float::s;
+    w.index = index;
+    w.start = start;
+    w.end = end;
+    w.readReqs = readReqs;
+    w.writeReqs = writeReqs;
+    w.readBytes = readBytes;
+    w.writeBytes = writeBytes;
+    w.readBandwidth = seconds > 0 ? readBytes / seconds : 0;
+    w.writeBandwidth = seconds > 0 ? writeBytes / seconds : 0;
+    for (unsigned i = 0; i < NumQuantiles; i++) {
+        w.readLatency[i] = readLatency.quantile(Quantiles[i]);
+        w.writeLatency[i] = writeLatency.quantile(Quantiles[i]);
+    }
+    std::memcpy(w.heat, heat, sizeof(heat));
+
+    w.seq.store(seq + 2, std::memory_order_release);
+    header->windows.store(index + 1, std::memory_order_release);
+
+    readReqs = 0;
+    writeReqs = 0;
+    readBytes = 0;
+    writeBytes = 0;
+    readLatency.reset();
+    writeLatency.reset();
+    std::memset(heat, 0, sizeof(heat));
+}
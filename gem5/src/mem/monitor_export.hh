@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Windowed export of the traffic seen by a CommMonitor to a ring of
+ * slots in POSIX shared memory, so another process can follow the
+ * memory system while the simulation runs.
+ *
+ * The segment starts with a Header, padded to HeaderSize bytes,
+ * followed by numSlots Window records. Window n is written to slot
+ * n % numSlots. The simulator is the only writer and never waits for
+ * readers: every slot is guarded by a sequence number, which is odd
+ * while the slot is written, and the header counts the windows
+ * completed. A reader copies a slot and keeps it if the sequence
+ * number was even and unchanged before and after the copy.
+ * util/monitor_view.py is such a reader.
+ *
+ * The segment is left in place at exit, so the last windows can still
+ * be read. It lives in /dev/shm on Linux.
+ */
+
+#ifndef __MEM_MONITOR_EXPORT_HH__
+#define __MEM_MONITOR_EXPORT_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "base/quantile_sketch.hh"
+#include "base/types.hh"
+
+class MonitorExport
+{
+  public:
+    static const uint32_t Version = 1;
+    static const unsigned HeatBins = 64;
+    static const size_t HeaderSize = 64;
+
+    /** Latency quantiles reported for every window */
+    static const unsigned NumQuantiles = 4;
+    static const double Quantiles[NumQuantiles];
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotSize;
+        uint32_t numSlots;
+        uint32_t heatBins;
+        uint64_t ticksPerSecond;
+        /** Address range of the heat map, end inclusive */
+        uint64_t heatStart;
+        uint64_t heatEnd;
+        /** Number of windows completed */
+        std::atomic<uint64_t> windows;
+    };
+
+    /** All fields are 64 bits wide, so the layout has no padding */
+    struct Window
+    {
+        std::atomic<uint64_t> seq;
+        uint64_t index;
+        uint64_t start;
+        uint64_t end;
+        uint64_t readReqs;
+        uint64_t writeReqs;
+        uint64_t readBytes;
+        uint64_t writeBytes;
+        /** Bytes per second */
+        double readBandwidth;
+        double writeBandwidth;
+        /** Request to response latency in ticks, per quantile */
+        double readLatency[NumQuantiles];
+        double writeLatency[NumQuantiles];
+        /** Requests per slice of the address range in the header */
+        uint64_t heat[HeatBins];
+    };
+
+    /**
+     * @param shm_name Name of the shared memory segment
+     * @param num_slots Number of windows kept in the ring
+     */
+    MonitorExport(const std::string &shm_name, unsigned num_slots);
+    ~MonitorExport();
+
+    /** Set the address range, end inclusive, covered by the heat map. */
+    void setHeatRange(Addr start, Addr end);
+
+    void
+    request(bool is_read, Addr addr, unsigned size)
+    {
+        if (is_read) {
+            readReqs++;
+        } else {
+            writeReqs++;
+            writeBytes += size;
+        }
+        if (heatSlice && addr >= heatStart && addr <= heatEnd)
+            heat[(addr - heatStart) / heatSlice]++;
+    }
+
+    void
+    response(bool is_read, Tick latency, unsigned size)
+    {
+        if (is_read) {
+            readBytes += size;
+            readLatency.sample(latency);
+        } else {
+            writeLatency.sample(latency);
+        }
+    }
+
+    /** Publish the window [start, end) and start a new one. */
+    void endWindow(Tick start, Tick end);
+
+  private:
+    std::string name;
+    size_t size;
+    Header *header;
+    Window *slots;
+    unsigned numSlots;
+
+    Addr heatStart;
+    Addr heatEnd;
+    Addr heatSlice;
+
+    /** Accumulators of the current window */
+    uint64_t readReqs;
+    uint64_t writeReqs;
+    uint64_t readBytes;
+    uint64_t writeBytes;
+    QuantileSketch readLatency;
+    QuantileSketch writeLatency;
+    uint64_t heat[HeatBins];
+};
+
+#endif // __MEM_MONITOR_EXPORT_HH__
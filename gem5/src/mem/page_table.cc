@@ -45,6 +45,130 @@
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
+EmulationPageTable::Node::Node(bool leaf) : used(0)
+{
+    if (leaf)
+        entries.reset(new Entry[RadixFanout]);
+    else
+        children.reset(new std::unique_ptr<Node>[RadixFanout]);
+}
+
+EmulationPageTable::Entry *
+EmulationPageTable::findEntry(Addr vpn)
+{
+    if (vpn >> (RadixLevels * RadixBits)) {
+        auto it = overflow.find(vpn);
+        return it == overflow.end() ? nullptr : &it->second;
+    }
+
+    const Node *node = &root;
+    for (unsigned level = RadixLevels - 1; level > 0; --level) {
+        node = node->children[radixIndex(vpn, level)].get();
+        if (!node)
+            return nullptr;
+    }
+
+    unsigned i = radixIndex(vpn, 0);
+    return node->valid[i] ? &node->entries[i] : nullptr;
+}
+
+void
+EmulationPageTable::insert(Addr vpn, const Entry &entry)
+{
+    if (vpn >> (RadixLevels * RadixBits)) {
+        if (overflow.emplace(vpn, entry).second)
+            ++numPages;
+        else
+            overflow[vpn] = entry;
+        return;
+    }
+
+    Node *node = &root;
+    for (unsigned level = RadixLevels - 1; level > 0; --level) {
+        std::unique_ptr<Node> &child = node->children[radixIndex(vpn, level)];
+        if (!child) {
+            child.reset(new Node(level == 1));
+            ++node->used;
+        }
+        node = child.get();
+    }
+
+    unsigned i = radixIndex(vpn, 0);
+    if (!node->valid[i]) {
+        node->valid.set(i);
+        ++node->used;
+        ++numPages;
+    }
+    node->entries[i] = entry;
+}
+
+void
+EmulationPageTable::erase(Addr vpn)
+{
+    CachedTranslation &cached = cache[vpn % CacheSize];
+    if (cached.vpn == vpn)
+        cached.vpn = MaxAddr;
+
+    --numPages;
+
+    if (vpn >> (RadixLevels * RadixBits)) {
+        M5_VAR_USED size_t erased = overflow.erase(vpn);
+        assert(erased);
+        return;
+    }
+
+    Node *path[RadixLevels];
+    Node *node = &root;
+    for (unsigned level = RadixLevels - 1; level > 0; --level) {
+        path[level] = node;
+        node = node->children[radixIndex(vpn, level)].get();
+        assert(node);
+    }
+
+    unsigned i = radixIndex(vpn, 0);
+    assert(node->valid[i]);
+    node->valid.reset(i);
+    --node->used;
+
+    // free the nodes this leaves empty, bottom up, but keep the root
+    for (unsigned level = 1; level < RadixLevels && node->used == 0;
+         ++level) {
+        node = path[level];
+        node->children[radixIndex(vpn, level)].reset();
+        --node->used;
+    }
+}
+
+void
+EmulationPageTable::forEachEntry(
+    const std::function<void(Addr, const Entry &)> &f) const
+{
+    // depth-first over the tree, visiting children in index order
+    std::function<void(const Node &, unsigned, Addr)> visit =
+        [&](const Node &node, unsigned level, Addr prefix) {
+        for (unsigned i = 0; i < RadixFanout; ++i) {
+            Addr vpn = (prefix << RadixBits) | i;
+            if (level == 0) {
+                if (node.valid[i])
+                    f(vpn, node.entries[i]);
+            } else if (node.children[i]) {
+                visit(*node.children[i], level - 1, vpn);
+            }
+        }
+    };
+    visit(root, RadixLevels - 1, 0);
+
+    for (auto &it : overflow)
+        f(it.first, it.second);
+}
+
+void
+EmulationPageTable::invalidateCache()
+{
+    for (auto &cached : cache)
+        cached.vpn = MaxAddr;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -55,16 +179,12 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+        Addr vpn = vaddr >> pageShift;
+        // already mapped
+        panic_if(!clobber && findEntry(vpn),
+                 "EmulationPageTable::allocate: addr %#x already mapped",
+                 vaddr);
+        insert(vpn, Entry(paddr, flags));
 
         size -= pageSize;
         vaddr += pageSize;
@@ -82,12 +202,13 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        auto new_it M5_VAR_USED = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+        Addr vpn = vaddr >> pageShift;
+        Addr new_vpn = new_vaddr >> pageShift;
+        const Entry *old_entry = findEntry(vpn);
+        assert(old_entry && !findEntry(new_vpn));
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        insert(new_vpn, *old_entry);
+        erase(vpn);
         size -= pageSize;
         vaddr += pageSize;
         new_vaddr += pageSize;
@@ -97,8 +218,9 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    forEachEntry([this, addr_maps](Addr vpn, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vpn << pageShift, entry.paddr));
+    });
 }
 
 void
@@ -109,9 +231,7 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
+        erase(vaddr >> pageShift);
         size -= pageSize;
         vaddr += pageSize;
     }
@@ -124,7 +244,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     assert(pageOffset(vaddr) == 0);
 
     for (int64_t offset = 0; offset < size; offset += pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+        if (findEntry((vaddr + offset) >> pageShift))
             return false;
 
     return true;
@@ -133,11 +253,20 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    Addr vpn = vaddr >> pageShift;
+    CachedTranslation &cached = cache[vpn % CacheSize];
+
+    ++_lookups;
+    if (cached.vpn == vpn)
+        return cached.entry;
+
+    ++_walks;
+    Entry *entry = findEntry(vpn);
+    if (entry) {
+        cached.vpn = vpn;
+        cached.entry = entry;
+    }
+    return entry;
 }
 
 bool
@@ -172,17 +301,17 @@ EmulationPageTable::translate(RequestPtr req)
 void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
-    paramOut(cp, "ptable.size", pTable.size());
+    paramOut(cp, "ptable.size", numPages);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    size_t count = 0;
+    forEachEntry([this, &cp, &count](Addr vpn, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vpn << pageShift);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == numPages);
 }
 
 void
@@ -201,7 +330,7 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        insert(vaddr >> pageShift, Entry(paddr, flags));
     }
+    invalidateCache();
 }
-
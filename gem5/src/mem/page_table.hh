@@ -37,6 +37,9 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <bitset>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -60,24 +63,93 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    /**
+     * The mappings are kept in a radix tree indexed by virtual page
+     * number, resolving RadixBits of it per level. Pages beyond the
+     * reach of the tree (high addresses on 64-bit ISAs) go in a hash
+     * map instead.
+     */
+    static const unsigned RadixBits = 9;
+    static const unsigned RadixLevels = 4;
+    static const unsigned RadixFanout = 1 << RadixBits;
+
+    struct Node
+    {
+        /** Children of an interior node, null in a leaf. */
+        std::unique_ptr<std::unique_ptr<Node>[]> children;
+        /** Entries of a leaf, null in an interior node. */
+        std::unique_ptr<Entry[]> entries;
+        /** Which entries of a leaf are mapped. */
+        std::bitset<RadixFanout> valid;
+        /** Number of children or mapped entries. */
+        unsigned used;
+
+        explicit Node(bool leaf);
+    };
+
+    /** Root of the radix tree, an interior node. */
+    Node root;
+
+    /** Pages whose number does not fit in the radix tree. */
+    std::unordered_map<Addr, Entry> overflow;
+
+    /** Number of mapped pages. */
+    size_t numPages;
+
+    /**
+     * Direct-mapped cache of recent translations in front of the
+     * tree. Entries are dropped when their page is unmapped.
+     */
+    static const unsigned CacheSize = 64;
+    struct CachedTranslation
+    {
+        Addr vpn;
+        Entry *entry;
+    };
+    CachedTranslation cache[CacheSize];
+
+    /** Lookups, and lookups that missed the cache and walked. */
+    uint64_t _lookups;
+    uint64_t _walks;
 
     const Addr pageSize;
     const Addr offsetMask;
+    const unsigned pageShift;
 
     const uint64_t _pid;
     const std::string _name;
 
+    static unsigned
+    radixIndex(Addr vpn, unsigned level)
+    {
+        return (vpn >> (level * RadixBits)) & (RadixFanout - 1);
+    }
+
+    /** Walk the table for a page, returning its entry or nullptr. */
+    Entry *findEntry(Addr vpn);
+
+    /** Map a page, replacing any entry it has. */
+    void insert(Addr vpn, const Entry &entry);
+
+    /** Unmap a page, which must be mapped. */
+    void erase(Addr vpn);
+
+    /** Call f for every mapping, in virtual page order for the tree. */
+    void forEachEntry(
+        const std::function<void(Addr, const Entry &)> &f) const;
+
+    void invalidateCache();
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
+            root(false), numPages(0), _lookups(0), _walks(0),
             pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name)
+            pageShift(floorLog2(_pageSize)), _pid(_pid), _name(__name)
     {
         assert(isPowerOf2(pageSize));
+        invalidateCache();
     }
 
     uint64_t pid() const { return _pid; };
@@ -155,6 +227,12 @@ class EmulationPageTable : public Serializable
 
     void getMappings(std::vector<std::pair<Addr, Addr>> *addr_mappings);
 
+    /** Number of lookup() calls. */
+    uint64_t lookups() const { return _lookups; }
+
+    /** Number of lookups that missed the translation cache. */
+    uint64_t walks() const { return _walks; }
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
@@ -52,10 +52,13 @@
 #include <iostream>
 #include <string>
 
+#include "base/hostinfo.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "sim/eventq.hh"
 
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
@@ -73,9 +76,11 @@ using namespace std;
 
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
+                               bool mmap_using_noreserve,
+                               Enums::HostHugePages huge_pages) :
     _name(_name), rangeCache(addrMap.end()), size(0),
-    mmapUsingNoReserve(mmap_using_noreserve)
+    mmapUsingNoReserve(mmap_using_noreserve), hugePages(huge_pages),
+    lastBackingStore(0)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
@@ -203,9 +208,51 @@ PhysicalMemory::createBackingStore(AddrRange range,
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
-                                    PROT_READ | PROT_WRITE,
-                                    map_flags, -1, 0);
+    size_t map_size = range.size();
+    uint8_t* pmem = (uint8_t*) MAP_FAILED;
+
+    // huge pages cover whole huge pages, so round the mapping up
+    size_t huge_page_size = procInfo("/proc/meminfo", "Hugepagesize:") * 1024;
+    if (!huge_page_size)
+        huge_page_size = 2 * 1024 * 1024;
+    if (hugePages != Enums::normal)
+        map_size = roundUp(range.size(), huge_page_size);
+
+#ifdef MAP_HUGETLB
+    if (hugePages == Enums::hugetlb) {
+        pmem = (uint8_t*) mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                               map_flags | MAP_HUGETLB, -1, 0);
+        if (pmem == (uint8_t*) MAP_FAILED)
+            warn("Could not get %d bytes of huge pages for range %s, "
+                 "using transparent huge pages\n", map_size,
+                 range.to_string());
+    }
+#endif
+
+    if (pmem == (uint8_t*) MAP_FAILED && hugePages != Enums::normal) {
+        // over-allocate to align the mapping to a huge page, as the
+        // kernel only uses transparent huge pages for aligned ranges
+        uint8_t* raw = (uint8_t*) mmap(NULL, map_size + huge_page_size,
+                                       PROT_READ | PROT_WRITE,
+                                       map_flags, -1, 0);
+        if (raw != (uint8_t*) MAP_FAILED) {
+            pmem = (uint8_t*) roundUp((uintptr_t) raw, huge_page_size);
+            if (pmem != raw)
+                munmap(raw, pmem - raw);
+            munmap(pmem + map_size, raw + huge_page_size - pmem);
+#ifdef MADV_HUGEPAGE
+            if (madvise(pmem, map_size, MADV_HUGEPAGE) != 0)
+                warn("Transparent huge pages are not available for "
+                     "range %s\n", range.to_string());
+#else
+            warn_once("Transparent huge pages are not supported on this "
+                      "host\n");
+#endif
+        }
+    } else if (hugePages == Enums::normal) {
+        pmem = (uint8_t*) mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                               map_flags, -1, 0);
+    }
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
@@ -213,10 +260,20 @@ PhysicalMemory::createBackingStore(AddrRange range,
               range.to_string());
     }
 
+    // place the pages with the thread simulating the memory; nothing
+    // has touched them yet, so the policy applies to all of them
+    uint32_t eventq_index = _memories.front()->params()->eventq_index;
+    if (eventq_index < eventqHostNodes.size() &&
+        !bindMemoryToHostNode(pmem, map_size, eventqHostNodes[eventq_index])) {
+        warn("Could not place range %s on host NUMA node %d\n",
+             range.to_string(), eventqHostNodes[eventq_index]);
+    }
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map);
+    mappedSize.push_back(map_size);
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -229,8 +286,8 @@ PhysicalMemory::createBackingStore(AddrRange range,
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
-    for (auto& s : backingStore)
-        munmap((char*)s.pmem, s.range.size());
+    for (size_t i = 0; i < backingStore.size(); ++i)
+        munmap((char*)backingStore[i].pmem, mappedSize[i]);
 }
 
 bool
@@ -252,6 +309,24 @@ PhysicalMemory::isMemAddr(Addr addr) const
     }
 }
 
+uint8_t *
+PhysicalMemory::hostAddr(Addr addr, Addr size) const
+{
+    assert(size > 0);
+    for (size_t n = 0; n < backingStore.size(); ++n) {
+        // start with the entry that matched last time
+        size_t i = (lastBackingStore + n) % backingStore.size();
+        const BackingStoreEntry& entry = backingStore[i];
+        if (entry.inAddrMap && addr >= entry.range.start() &&
+            addr <= entry.range.end() &&
+            size - 1 <= entry.range.end() - addr) {
+            lastBackingStore = i;
+            return entry.pmem + (addr - entry.range.start());
+        }
+    }
+    return nullptr;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -41,6 +41,7 @@
 #define __MEM_PHYSICAL_HH__
 
 #include "base/addr_range_map.hh"
+#include "enums/HostHugePages.hh"
 #include "mem/packet.hh"
 
 /**
@@ -133,10 +134,20 @@ class PhysicalMemory : public Serializable
     // Let the user choose if we reserve swap space when calling mmap
     const bool mmapUsingNoReserve;
 
+    // Host pages to use for the backing store
+    const Enums::HostHugePages hugePages;
+
+    // Length of the host mapping of each backing store entry, which
+    // is rounded up to whole pages when using huge pages
+    std::vector<size_t> mappedSize;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // the backing store entry that hostAddr last matched
+    mutable size_t lastBackingStore;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -164,7 +175,8 @@ class PhysicalMemory : public Serializable
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   Enums::HostHugePages huge_pages);
 
     /**
      * Unmap all the backing store we have used.
@@ -186,6 +198,18 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Get a host pointer to a range of guest memory that is part of
+     * the global address map, for functional accesses that are known
+     * not to race with anything in the memory system.
+     *
+     * @param addr Start of the range
+     * @param size Size of the range in bytes
+     * @return Host address of addr, or nullptr if the range is not
+     *         covered by a single backing store
+     */
+    uint8_t *hostAddr(Addr addr, Addr size) const;
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
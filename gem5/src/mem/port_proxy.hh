@@ -67,6 +67,8 @@
 #include "mem/port.hh"
 #include "sim/byteswap.hh"
 
+class System;
+
 /**
  * This object is a proxy for a structural port, to be used for debug
  * accesses.
@@ -78,6 +80,11 @@
  *
  * The addresses are interpreted as physical addresses.
  *
+ * When given the system owning the memory, accesses that fall in a
+ * single backing store are done directly on the host memory whenever
+ * the system says this is coherent (see System::functionalBackdoor()),
+ * and otherwise go through the port.
+ *
  * @sa SETranslatingProxy
  * @sa FSTranslatingProxy
  */
@@ -91,9 +98,21 @@ class PortProxy
     /** Granularity of any transactions issued through this proxy. */
     const unsigned int _cacheLineSize;
 
+    /** System whose backing store may be accessed directly, if any. */
+    System *_system;
+
+    /**
+     * Get a host pointer for an access of size bytes at physical
+     * address addr if it may bypass the port.
+     *
+     * @return Host address, or nullptr if the port has to be used
+     */
+    uint8_t *backdoor(Addr addr, int size) const;
+
   public:
-    PortProxy(MasterPort &port, unsigned int cacheLineSize) :
-        _port(port), _cacheLineSize(cacheLineSize) { }
+    PortProxy(MasterPort &port, unsigned int cacheLineSize,
+              System *system = nullptr) :
+        _port(port), _cacheLineSize(cacheLineSize), _system(system) { }
     virtual ~PortProxy() { }
 
     /**
@@ -0,0 +1,60 @@
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from BaseMemProbe import BaseMemProbe
+
+# The miss attribution probe is meant to be hooked up to a
+# CommMonitor between the last-level cache and the memory, where
+# every read request is a miss and every write a writeback (or a
+# write-through). It attributes both to the PC of the request and to
+# the address region it falls in, and reports the heaviest PCs and
+# regions, resolved to symbols where possible, at every stats dump.
+class MissAttributionProbe(BaseMemProbe):
+    type = 'MissAttributionProbe'
+    cxx_header = "mem/probes/miss_attribution.hh"
+
+    line_size = Param.Unsigned(Parent.cache_line_size,
+                               "Cache line size in bytes")
+
+    region_size = Param.MemorySize('4kB', "Size of the address regions "
+                                   "misses and writebacks are counted in")
+
+    top_k = Param.Unsigned(20, "Number of PCs and regions reported")
+    sketch_width = Param.Unsigned(2048, "Counters per row of the "
+                                  "count-min sketches")
+    sketch_depth = Param.Unsigned(4, "Rows of the count-min sketches")
+
+    # writebacks carry no PC, so they are attributed to the miss that
+    # brought the line in, as remembered in a direct-mapped table
+    fill_table_entries = Param.Unsigned(65536, "Entries in the table "
+                                        "of fills used to attribute "
+                                        "writebacks")
+
+    write_energy = Param.Float(0.0, "Energy to write a byte to memory (pJ)")
+
+    output = Param.String("miss_attribution.txt", "Report file name")
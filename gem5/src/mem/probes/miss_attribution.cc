@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/miss_attribution.hh"
+
+#include "base/callback.hh"
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/loader/symtab.hh"
+#include "params/MissAttributionProbe.hh"
+#include "sim/core.hh"
+
+MissAttributionProbe::MissAttributionProbe(MissAttributionProbeParams *p)
+    : BaseMemProbe(p),
+      lineSize(p->line_size),
+      regionSize(p->region_size),
+      writeEnergyPerByte(p->write_energy),
+      fills(p->fill_table_entries, Fill{0, 0, 0, false}),
+      pcMisses(p->top_k, p->sketch_width, p->sketch_depth),
+      pcWritebacks(p->top_k, p->sketch_width, p->sketch_depth),
+      regionMisses(p->top_k, p->sketch_width, p->sketch_depth),
+      regionWritebacks(p->top_k, p->sketch_width, p->sketch_depth),
+      pcWritebackBytes(p->top_k, p->sketch_width, p->sketch_depth),
+      regionWritebackBytes(p->top_k, p->sketch_width, p->sketch_depth),
+      output(simout.create(p->output))
+{
+    fatal_if(!isPowerOf2(lineSize), "%s: line size must be a power of 2\n",
+             name());
+    fatal_if(!isPowerOf2(regionSize) || regionSize < lineSize,
+             "%s: region size must be a power of 2 no smaller than a "
+             "line\n", name());
+    fatal_if(!isPowerOf2(p->fill_table_entries),
+             "%s: fill table entries must be a power of 2\n", name());
+}
+
+void
+MissAttributionProbe::regStats()
+{
+    BaseMemProbe::regStats();
+
+    using namespace Stats;
+
+    misses
+        .name(name() + ".misses")
+        .desc("Number of read requests (misses) seen");
+
+    writebacks
+        .name(name() + ".writebacks")
+        .desc("Number of writes (writebacks and write-throughs) seen");
+
+    unattributedWritebacks
+        .name(name() + ".unattributedWritebacks")
+        .desc("Number of writes whose line fill was not remembered");
+
+    writebackBytes
+        .name(name() + ".writebackBytes")
+        .desc("Number of bytes written");
+
+    writeEnergy
+        .name(name() + ".writeEnergy")
+        .desc("Energy of the writes (pJ)");
+    writeEnergy = writebackBytes * writeEnergyPerByte;
+
+    registerResetCallback(
+        new MakeCallback<MissAttributionProbe,
+                         &MissAttributionProbe::resetCounts>(this));
+    registerDumpCallback(
+        new MakeCallback<MissAttributionProbe,
+                         &MissAttributionProbe::report>(this));
+}
+
+void
+MissAttributionProbe::handleRequest(const ProbePoints::PacketInfo &pi)
+{
+    const Addr line = pi.addr & ~Addr(lineSize - 1);
+    Fill &fill = fills[(line / lineSize) & (fills.size() - 1)];
+
+    if (pi.cmd.isRead()) {
+        const uint64_t region = regionKey(pi.addr, pi.vaddr);
+
+        misses++;
+        pcMisses.add(pi.pc);
+        regionMisses.add(region);
+
+        fill.line = line;
+        fill.pc = pi.pc;
+        fill.region = region;
+        fill.valid = true;
+    } else if (pi.cmd.isWrite()) {
+        Addr pc = 0;
+        uint64_t region = regionKey(pi.addr, 0);
+        if (fill.valid && fill.line == line) {
+            pc = fill.pc;
+            region = fill.region;
+        } else {
+            unattributedWritebacks++;
+        }
+
+        writebacks++;
+        writebackBytes += pi.size;
+        pcWritebacks.add(pc);
+        regionWritebacks.add(region);
+        if (writeEnergyPerByte > 0) {
+            pcWritebackBytes.add(pc, pi.size);
+            regionWritebackBytes.add(region, pi.size);
+        }
+    }
+}
+
+void
+MissAttributionProbe::resetCounts()
+{
+    // the fill table is state of the caches rather than a count, so
+    // keep it to attribute writebacks of lines filled before the reset
+    pcMisses.reset();
+    pcWritebacks.reset();
+    regionMisses.reset();
+    regionWritebacks.reset();
+    pcWritebackBytes.reset();
+    regionWritebackBytes.reset();
+}
+
+std::string
+MissAttributionProbe::describePC(Addr pc) const
+{
+    if (pc == 0)
+        return "unknown";
+
+    std::string symbol;
+    Addr symaddr;
+    if (debugSymbolTable &&
+        debugSymbolTable->findNearestSymbol(pc, symbol, symaddr)) {
+        return csprintf("%#x %s+%#x", pc, symbol, pc - symaddr);
+    }
+    return csprintf("%#x", pc);
+}
+
+std::string
+MissAttributionProbe::describeRegion(uint64_t key) const
+{
+    const Addr base = key & ~Addr(1);
+    const bool physical = key & 1;
+    std::string desc = csprintf("%s %#x-%#x", physical ? "phys" : "virt",
+                                base, base + regionSize - 1);
+
+    // only name regions close to a symbol, the nearest symbol of a
+    // heap or stack address is usually unrelated to it
+    std::string symbol;
+    Addr symaddr;
+    if (!physical && debugSymbolTable &&
+        debugSymbolTable->findNearestSymbol(base, symbol, symaddr) &&
+        base - symaddr < (1 << 20)) {
+        desc += csprintf(" %s+%#x", symbol, base - symaddr);
+    }
+    return desc;
+}
+
+void
+MissAttributionProbe::printTop(std::ostream &os, const std::string &title,
+                               const TopKSketch &sketch, bool pcs,
+                               const TopKSketch *bytes) const
+{
+    ccprintf(os, "%s (total %d)\n", title, sketch.total());
+    if (!sketch.total())
+        return;
+
+    unsigned rank = 0;
+    for (const auto &e : sketch.top()) {
+        ccprintf(os, "  %3d %12d %6.2f%%", ++rank, e.second,
+                 100.0 * e.second / sketch.total());
+        if (bytes) {
+            ccprintf(os, " %12.1f nJ",
+                     bytes->estimate(e.first) * writeEnergyPerByte / 1000);
+        }
+        ccprintf(os, "  %s\n",
+                 pcs ? describePC(e.first) : describeRegion(e.first));
+    }
+}
+
+void
+MissAttributionProbe::report()
+{
+    std::ostream &os = *output->stream();
+    const bool energy = writeEnergyPerByte > 0;
+
+    ccprintf(os, "---------- Miss attribution at tick %d ----------\n",
+             curTick());
+    printTop(os, "Misses by PC", pcMisses, true);
+    printTop(os, "Writebacks by PC of the fill", pcWritebacks, true,
+             energy ? &pcWritebackBytes : nullptr);
+    printTop(os, "Misses by region", regionMisses, false);
+    printTop(os, "Writebacks by region", regionWritebacks, false,
+             energy ? &regionWritebackBytes : nullptr);
+    ccprintf(os, "\n");
+    os.flush();
+}
+
+MissAttributionProbe *
+MissAttributionProbeParams::create()
+{
+    return new MissAttributionProbe(this);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Attribution of last-level cache misses and writebacks to PCs and
+ * address regions.
+ */
+
+#ifndef __MEM_PROBES_MISS_ATTRIBUTION_HH__
+#define __MEM_PROBES_MISS_ATTRIBUTION_HH__
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/top_k_sketch.hh"
+#include "mem/probes/base.hh"
+#include "sim/stats.hh"
+
+struct MissAttributionProbeParams;
+
+/**
+ * Probe counting the misses and writebacks seen below a last-level
+ * cache per requesting PC and per address region. Counts are kept in
+ * bounded top-K sketches, so the cost does not grow with the number
+ * of PCs or the footprint. Regions are virtual when the request
+ * carries its virtual address, which lets them be named after the
+ * symbols of the binary, and physical otherwise.
+ *
+ * Writebacks do not carry the PC or virtual address of the data, so
+ * they are charged to the miss that last filled the line. The fills
+ * are remembered in a direct-mapped table, and writebacks of lines no
+ * longer in the table are counted as unattributed.
+ *
+ * The ranking since the last stats reset is written to the report
+ * file at every stats dump.
+ */
+class MissAttributionProbe : public BaseMemProbe
+{
+  public:
+    MissAttributionProbe(MissAttributionProbeParams *p);
+
+    void regStats() override;
+
+  protected:
+    void handleRequest(const ProbePoints::PacketInfo &pkt_info) override;
+
+    /** Region of an access, physical regions have the low bit set. */
+    uint64_t
+    regionKey(Addr paddr, Addr vaddr) const
+    {
+        return vaddr ? vaddr & ~(regionSize - 1) :
+            (paddr & ~(regionSize - 1)) | 1;
+    }
+
+    /** Write the rankings to the report, called on stats dumps. */
+    void report();
+
+    /** Restart the counts, called on stats resets. */
+    void resetCounts();
+
+    /**
+     * Write the ranking of a sketch. With the bytes of the entries,
+     * the energy of writing them is printed as well.
+     */
+    void printTop(std::ostream &os, const std::string &title,
+                  const TopKSketch &sketch, bool pcs,
+                  const TopKSketch *bytes = nullptr) const;
+
+    std::string describePC(Addr pc) const;
+    std::string describeRegion(uint64_t key) const;
+
+    /** A line filled by a miss, and who it is charged to */
+    struct Fill
+    {
+        Addr line;
+        Addr pc;
+        uint64_t region;
+        bool valid;
+    };
+
+    const unsigned lineSize;
+    const Addr regionSize;
+    const double writeEnergyPerByte;
+
+    std::vector<Fill> fills;
+
+    TopKSketch pcMisses;
+    TopKSketch pcWritebacks;
+    TopKSketch regionMisses;
+    TopKSketch regionWritebacks;
+
+    /** Bytes written per entry, kept when write energy is reported */
+    TopKSketch pcWritebackBytes;
+    TopKSketch regionWritebackBytes;
+
+    OutputStream *output;
+
+    Stats::Scalar misses;
+    Stats::Scalar writebacks;
+    Stats::Scalar unattributedWritebacks;
+    Stats::Scalar writebackBytes;
+    Stats::Formula writeEnergy;
+};
+
+#endif //__MEM_PROBES_MISS_ATTRIBUTION_HH__
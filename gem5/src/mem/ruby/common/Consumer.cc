@@ -36,20 +36,64 @@ Consumer::scheduleEvent(Cycles timeDelta)
     scheduleEventAbsolute(em->clockEdge(timeDelta));
 }
 
+void
+Consumer::advanceWakeupWindow(Tick base)
+{
+    Tick period = em->clockPeriod();
+    if (period == m_wakeup_period && base >= m_wakeup_base &&
+        (base - m_wakeup_base) % period == 0) {
+        // Wakeups before the new base have already happened
+        Tick shift = (base - m_wakeup_base) / period;
+        m_wakeup_mask = shift < WakeupWindowSize ? m_wakeup_mask >> shift : 0;
+    } else {
+        // The clock was changed or reset, so the window no longer lines
+        // up with the clock edges. Keep whatever is pending in the set.
+        for (int i = 0; m_wakeup_mask != 0; i++, m_wakeup_mask >>= 1) {
+            if (m_wakeup_mask & 1)
+                m_scheduled_wakeups.insert(m_wakeup_base +
+                                           i * m_wakeup_period);
+        }
+        m_wakeup_period = period;
+    }
+    m_wakeup_base = base;
+
+    // Wakeups that were beyond the old window, or scheduled before the
+    // clock changed, may now fall on one of the window's edges. Move
+    // them to the mask so that alreadyScheduled() finds them.
+    Tick end = base + WakeupWindowSize * m_wakeup_period;
+    auto it = m_scheduled_wakeups.lower_bound(base);
+    while (it != m_scheduled_wakeups.end() && *it < end) {
+        int bit = wakeupWindowBit(*it);
+        if (bit >= 0) {
+            m_wakeup_mask |= ULL(1) << bit;
+            it = m_scheduled_wakeups.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
+    Tick t = em->clockEdge();
+    if (t != m_wakeup_base)
+        advanceWakeupWindow(t);
+
     if (!alreadyScheduled(evt_time)) {
         // This wakeup is not redundant
+        if (m_wakeup_name.empty())
+            m_wakeup_name = em->name() + ".wakeup";
         auto *evt = new EventFunctionWrapper(
-            [this]{ wakeup(); }, "Consumer Event", true);
+            [this]{ wakeup(); }, m_wakeup_name, true);
 
         em->schedule(evt, evt_time);
         insertScheduledWakeupTime(evt_time);
     }
 
-    Tick t = em->clockEdge();
-    set<Tick>::iterator bit = m_scheduled_wakeups.begin();
-    set<Tick>::iterator eit = m_scheduled_wakeups.lower_bound(t);
-    m_scheduled_wakeups.erase(bit,eit);
+    if (!m_scheduled_wakeups.empty()) {
+        set<Tick>::iterator bit = m_scheduled_wakeups.begin();
+        set<Tick>::iterator eit = m_scheduled_wakeups.lower_bound(t);
+        m_scheduled_wakeups.erase(bit,eit);
+    }
 }
@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <set>
+#include <string>
 
 #include "sim/clocked_object.hh"
 
@@ -44,7 +45,7 @@ class Consumer
 {
   public:
     Consumer(ClockedObject *_em)
-        : em(_em)
+        : em(_em), m_wakeup_base(0), m_wakeup_period(0), m_wakeup_mask(0)
     {
     }
 
@@ -57,25 +58,72 @@ class Consumer
     virtual void storeEventInfo(int info) {}
 
     bool
-    alreadyScheduled(Tick time)
+    alreadyScheduled(Tick time) const
     {
+        int bit = wakeupWindowBit(time);
+        if (bit >= 0)
+            return (m_wakeup_mask >> bit) & 1;
         return m_scheduled_wakeups.find(time) != m_scheduled_wakeups.end();
     }
 
     void
     insertScheduledWakeupTime(Tick time)
     {
-        m_scheduled_wakeups.insert(time);
+        int bit = wakeupWindowBit(time);
+        if (bit >= 0)
+            m_wakeup_mask |= ULL(1) << bit;
+        else
+            m_scheduled_wakeups.insert(time);
     }
 
     void scheduleEventAbsolute(Tick timeAbs);
 
+    // The event queue (and thus thread) this consumer is woken up in
+    EventQueue *consumerEventQueue() const { return em->eventQueue(); }
+
   protected:
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_scheduled_wakeups;
+    /** Number of clock edges covered by the wakeup window */
+    static const int WakeupWindowSize = 64;
+
+    /**
+     * Return the bit of m_wakeup_mask that tracks a wakeup at the given
+     * tick, or -1 if the tick is not one of the window's clock edges.
+     */
+    int
+    wakeupWindowBit(Tick time) const
+    {
+        if (time < m_wakeup_base || m_wakeup_period == 0)
+            return -1;
+        Tick offset = time - m_wakeup_base;
+        Tick bit = offset / m_wakeup_period;
+        if (bit >= WakeupWindowSize || bit * m_wakeup_period != offset)
+            return -1;
+        return bit;
+    }
+
+    /** Slide the wakeup window forward so that it starts at base. */
+    void advanceWakeupWindow(Tick base);
+
     ClockedObject *em;
+
+    /**
+     * Wakeups already scheduled on one of the next WakeupWindowSize
+     * clock edges of em are kept as bits of m_wakeup_mask, bit i standing
+     * for m_wakeup_base + i * m_wakeup_period. Nearly all wakeups are a
+     * few cycles away, so this avoids a tree insert and erase per wakeup.
+     * Wakeups further away, or off em's clock edges (e.g. a message
+     * arriving from another clock domain), go to m_scheduled_wakeups.
+     */
+    Tick m_wakeup_base;
+    Tick m_wakeup_period;
+    uint64_t m_wakeup_mask;
+    std::set<Tick> m_scheduled_wakeups;
+
+    /** Name of the wakeup events, which belong to em */
+    std::string m_wakeup_name;
 };
 
 inline std::ostream&
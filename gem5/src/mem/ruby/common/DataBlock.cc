@@ -33,17 +33,21 @@
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    alloc();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    uint32_t size = RubySystem::getBlockSizeBytes();
+    if (size <= InlineBytes) {
+        m_data = m_inline;
+        m_alloc = false;
+    } else {
+        m_data = new uint8_t[size];
+        m_alloc = true;
+    }
 }
 
 void
@@ -43,6 +43,7 @@ class DataBlock
     DataBlock()
     {
         alloc();
+        clear();
     }
 
     DataBlock(const DataBlock &cp);
@@ -70,9 +71,18 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
+    /**
+     * Blocks up to this size live inside the DataBlock itself, so
+     * creating and copying blocks (and the messages carrying them) does
+     * not touch the heap. Larger block sizes are allocated separately.
+     */
+    static const int InlineBytes = 64;
+
     void alloc();
     uint8_t *m_data;
+    //! True if m_data was allocated on the heap and is owned by us
     bool m_alloc;
+    uint8_t m_inline[InlineBytes];
 };
 
 inline void
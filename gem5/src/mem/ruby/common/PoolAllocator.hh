@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_POOLALLOCATOR_HH__
+#define __MEM_RUBY_COMMON_POOLALLOCATOR_HH__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/**
+ * A minimal standard allocator that recycles single-object allocations
+ * through a per-type, per-thread free list. It is meant to be handed to
+ * std::allocate_shared, which rebinds it to the type of the combined
+ * object and reference count block, so every message type ends up with
+ * a pool of its own. Freed blocks are kept for reuse and only returned
+ * to the system when the thread exits.
+ */
+template <class T>
+class PoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    PoolAllocator() {}
+    template <class U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        if (n != 1)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+
+        std::vector<void *> &blocks = freeList().blocks;
+        if (blocks.empty())
+            return static_cast<T *>(::operator new(sizeof(T)));
+
+        void *p = blocks.back();
+        blocks.pop_back();
+        return static_cast<T *>(p);
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        if (n != 1)
+            ::operator delete(p);
+        else
+            freeList().blocks.push_back(p);
+    }
+
+  private:
+    struct FreeList
+    {
+        std::vector<void *> blocks;
+
+        ~FreeList()
+        {
+            for (auto p : blocks)
+                ::operator delete(p);
+        }
+    };
+
+    static FreeList &
+    freeList()
+    {
+        static thread_local FreeList list;
+        return list;
+    }
+};
+
+template <class T, class U>
+inline bool
+operator==(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+    return true;
+}
+
+template <class T, class U>
+inline bool
+operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+    return false;
+}
+
+#endif // __MEM_RUBY_COMMON_POOLALLOCATOR_HH__
@@ -33,6 +33,7 @@
 
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
@@ -65,6 +66,7 @@ GarnetNetwork::GarnetNetwork(const Params *p)
     m_buffers_per_data_vc = p->buffers_per_data_vc;
     m_buffers_per_ctrl_vc = p->buffers_per_ctrl_vc;
     m_routing_algorithm = p->routing_algorithm;
+    m_lookahead_bypass = p->lookahead_bypass;
 
     m_enable_fault_model = p->enable_fault_model;
     if (m_enable_fault_model)
@@ -112,6 +114,22 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // Regions of a partitioned network run in separate event queues and
+    // may drift apart by up to the shortest link between two of them
+    Tick quantum = MaxTick;
+    for (auto link : m_networklinks) {
+        if (link->crossesEventQueues())
+            quantum = std::min(quantum, link->latencyTicks());
+    }
+    for (auto link : m_creditlinks) {
+        if (link->crossesEventQueues())
+            quantum = std::min(quantum, link->latencyTicks());
+    }
+    if (quantum != MaxTick && simQuantum == 0) {
+        inform("%s: simulation quantum set to %d ticks\n", name(), quantum);
+        simQuantum = quantum;
+    }
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
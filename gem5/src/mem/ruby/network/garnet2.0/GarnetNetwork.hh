@@ -72,6 +72,7 @@ class GarnetNetwork : public Network
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
 
     bool isFaultModelEnabled() const { return m_enable_fault_model; }
+    bool isLookaheadBypassEnabled() const { return m_lookahead_bypass; }
     FaultModel* fault_model;
 
 
@@ -153,6 +154,7 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
     bool m_enable_fault_model;
+    bool m_lookahead_bypass;
 
     // Statistical variables
     Stats::Vector m_packets_received;
@@ -48,6 +48,9 @@ class GarnetNetwork(RubyNetwork):
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
+    lookahead_bypass = Param.Bool(False, "single-flit packets arriving at "
+        "an idle router use a route computed one hop early and go straight "
+        "to switch allocation, skipping the buffering pipeline stages")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
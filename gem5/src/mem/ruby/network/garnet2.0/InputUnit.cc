@@ -125,6 +125,15 @@ InputUnit::wakeup()
             // 1-cycle router
             // Flit goes for SA directly
             t_flit->advance_stage(SA_, m_router->curCycle());
+        } else if (t_flit->get_type() == HEAD_TAIL_ &&
+                   m_router->get_num_active_vcs() == 1 &&
+                   m_router->get_net_ptr()->isLookaheadBypassEnabled()) {
+            // Lookahead bypass
+            // The route was known one hop early and this single-flit
+            // packet is alone in the router, so there is no contention
+            // to buffer for: it goes for SA in the cycle it arrives.
+            t_flit->advance_stage(SA_, m_router->curCycle());
+            m_router->increment_bypass_activity();
         } else {
             assert(pipe_stages > 1);
             // Router delay is modeled by making flit wait in buffer for
@@ -60,12 +60,14 @@ class InputUnit : public Consumer
     set_vc_idle(int vc, Cycles curTime)
     {
         m_vcs[vc]->set_idle(curTime);
+        m_router->decrement_active_vcs();
     }
 
     inline void
     set_vc_active(int vc, Cycles curTime)
     {
         m_vcs[vc]->set_active(curTime);
+        m_router->increment_active_vcs();
     }
 
     inline void
@@ -40,7 +40,7 @@ NetworkLink::NetworkLink(const Params *p)
       m_type(NUM_LINK_TYPES_),
       m_latency(p->link_latency),
       linkBuffer(new flitBuffer()), link_consumer(nullptr),
-      link_srcQueue(nullptr), m_link_utilized(0),
+      link_srcQueue(nullptr), m_remote_consumer(false), m_link_utilized(0),
       m_vc_load(p->vcs_per_vnet * p->virt_nets)
 {
 }
@@ -50,6 +50,21 @@ NetworkLink::~NetworkLink()
     delete linkBuffer;
 }
 
+void
+NetworkLink::startup()
+{
+    ClockedObject::startup();
+
+    // When the network is partitioned into regions that run in separate
+    // event queues, the flit sent on this link at the end of one
+    // simulation quantum must not arrive before the next one starts.
+    m_remote_consumer = crossesEventQueues();
+    fatal_if(m_remote_consumer && latencyTicks() < simQuantum,
+             "%s: link latency (%d ticks) crosses event queues and must not "
+             "be shorter than the simulation quantum (%d ticks)", name(),
+             latencyTicks(), simQuantum);
+}
+
 void
 NetworkLink::setLinkConsumer(Consumer *consumer)
 {
@@ -68,13 +83,40 @@ NetworkLink::wakeup()
     if (link_srcQueue->isReady(curCycle())) {
         flit *t_flit = link_srcQueue->getTopFlit();
         t_flit->set_time(curCycle() + m_latency);
-        linkBuffer->insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_remote_consumer) {
+            std::lock_guard<std::mutex> lock(m_buffer_mutex);
+            linkBuffer->insert(t_flit);
+        } else {
+            linkBuffer->insert(t_flit);
+        }
+        scheduleConsumer(clockEdge(m_latency));
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
 }
 
+void
+NetworkLink::scheduleConsumer(Tick when)
+{
+    if (!m_remote_consumer) {
+        link_consumer->scheduleEventAbsolute(when);
+        return;
+    }
+
+    // The consumer's wakeup bookkeeping belongs to another thread. Relay
+    // the request through an event in the consumer's queue, which is
+    // inserted asynchronously at the next quantum boundary; startup()
+    // made sure that is no later than when. The relay runs ahead of all
+    // the default priority events of that tick, so the consumer is woken
+    // up once, along with any local wakeup for the same tick, as in a
+    // single queue run, whatever order the threads inserted the relays.
+    Consumer *consumer = link_consumer;
+    auto *evt = new EventFunctionWrapper(
+        [consumer, when]{ consumer->scheduleEventAbsolute(when); },
+        name() + ".remoteWakeup", true, Event::Delayed_Writeback_Pri);
+    consumer->consumerEventQueue()->schedule(evt, when);
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -100,5 +142,6 @@ CreditLinkParams::create()
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
+    std::lock_guard<std::mutex> lock(m_buffer_mutex);
     return linkBuffer->functionalWrite(pkt);
 }
@@ -35,6 +35,7 @@
 #define __MEM_RUBY_NETWORK_GARNET2_0_NETWORKLINK_HH__
 
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
@@ -52,27 +53,61 @@ class NetworkLink : public ClockedObject, public Consumer
     NetworkLink(const Params *p);
     ~NetworkLink();
 
+    void startup();
+
     void setLinkConsumer(Consumer *consumer);
     void setSourceQueue(flitBuffer *srcQueue);
     void setType(link_type type) { m_type = type; }
     link_type getType() { return m_type; }
     void print(std::ostream& out) const {}
     int get_id() const { return m_id; }
+
+    // Does the consumer run in another event queue than the link, i.e.,
+    // does the link cross between two regions of a partitioned network?
+    bool
+    crossesEventQueues() const
+    {
+        return link_consumer->consumerEventQueue() != eventQueue();
+    }
+    Tick latencyTicks() const { return cyclesToTicks(m_latency); }
     void wakeup();
 
     unsigned int getLinkUtilization() const { return m_link_utilized; }
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
 
-    inline bool isReady(Cycles curTime)
-    { return linkBuffer->isReady(curTime); }
+    inline bool
+    isReady(Cycles curTime)
+    {
+        if (!m_remote_consumer)
+            return linkBuffer->isReady(curTime);
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        return linkBuffer->isReady(curTime);
+    }
+
+    inline flit*
+    peekLink()
+    {
+        if (!m_remote_consumer)
+            return linkBuffer->peekTopFlit();
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        return linkBuffer->peekTopFlit();
+    }
 
-    inline flit* peekLink()       { return linkBuffer->peekTopFlit(); }
-    inline flit* consumeLink()    { return linkBuffer->getTopFlit(); }
+    inline flit*
+    consumeLink()
+    {
+        if (!m_remote_consumer)
+            return linkBuffer->getTopFlit();
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        return linkBuffer->getTopFlit();
+    }
 
     uint32_t functionalWrite(Packet *);
     void resetStats();
 
   private:
+    void scheduleConsumer(Tick when);
+
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
@@ -81,6 +116,12 @@ class NetworkLink : public ClockedObject, public Consumer
     Consumer *link_consumer;
     flitBuffer *link_srcQueue;
 
+    // Set when the consumer runs in another event queue, i.e., the link
+    // crosses between two regions of a partitioned network. linkBuffer
+    // is then shared between two threads and guarded by m_buffer_mutex.
+    bool m_remote_consumer;
+    std::mutex m_buffer_mutex;
+
     // Statistical variables
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
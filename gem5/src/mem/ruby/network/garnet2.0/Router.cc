@@ -54,6 +54,7 @@ Router::Router(const Params *p)
     m_virtual_networks = p->virt_nets;
     m_vc_per_vnet = p->vcs_per_vnet;
     m_num_vcs = m_virtual_networks * m_vc_per_vnet;
+    m_num_active_vcs = 0;
 
     m_routing_unit = new RoutingUnit(this);
     m_sw_alloc = new SwitchAllocator(this);
@@ -101,6 +102,11 @@ Router::wakeup()
         m_output_unit[outport]->wakeup();
     }
 
+    // A router woken up only for credits has no packet in any input VC,
+    // so there is nothing to allocate or traverse.
+    if (m_num_active_vcs == 0)
+        return;
+
     // Switch Allocation
     m_sw_alloc->wakeup();
 
@@ -216,6 +222,12 @@ Router::regStats()
         .name(name() + ".sw_output_arbiter_activity")
         .flags(Stats::nozero)
     ;
+
+    m_bypass_activity
+        .name(name() + ".bypass_activity")
+        .desc("single-flit packets that skipped the router pipeline")
+        .flags(Stats::nozero)
+    ;
 }
 
 void
@@ -95,6 +95,17 @@ class Router : public BasicRouter, public Consumer
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
+    // Number of input VCs currently holding a packet, across all inports
+    void increment_active_vcs() { m_num_active_vcs++; }
+    void decrement_active_vcs()
+    {
+        assert(m_num_active_vcs > 0);
+        m_num_active_vcs--;
+    }
+    int get_num_active_vcs() { return m_num_active_vcs; }
+
+    void increment_bypass_activity() { m_bypass_activity++; }
+
     std::string getPortDirectionName(PortDirection direction);
     void printFaultVector(std::ostream& out);
     void printAggregateFaultProbability(std::ostream& out);
@@ -119,6 +130,7 @@ class Router : public BasicRouter, public Consumer
   private:
     Cycles m_latency;
     int m_virtual_networks, m_num_vcs, m_vc_per_vnet;
+    int m_num_active_vcs;
     GarnetNetwork *m_network_ptr;
 
     std::vector<InputUnit *> m_input_unit;
@@ -135,6 +147,8 @@ class Router : public BasicRouter, public Consumer
     Stats::Scalar m_sw_output_arbiter_activity;
 
     Stats::Scalar m_crossbar_activity;
+
+    Stats::Scalar m_bypass_activity;
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET2_0_ROUTER_HH__
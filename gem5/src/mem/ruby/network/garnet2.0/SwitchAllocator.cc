@@ -351,7 +351,10 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 }
 
 // Wakeup the router next cycle to perform SA again
-// if there are flits ready.
+// if there are flits ready that are allowed to be sent.
+// A flit waiting for a free output VC or a credit does not
+// keep the router awake: the credit link wakes the router
+// up when the credit arrives.
 void
 SwitchAllocator::check_for_wakeup()
 {
@@ -359,7 +362,9 @@ SwitchAllocator::check_for_wakeup()
 
     for (int i = 0; i < m_num_inports; i++) {
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_input_unit[i]->need_stage(j, SA_, nextCycle)) {
+            if (m_input_unit[i]->need_stage(j, SA_, nextCycle) &&
+                send_allowed(i, j, m_input_unit[i]->get_outport(j),
+                             m_input_unit[i]->get_outvc(j))) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
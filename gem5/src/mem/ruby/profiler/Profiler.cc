@@ -376,6 +376,8 @@ Profiler::collateStats()
             AbstractController *ctr = (*it).second;
             Sequencer *seq = ctr->getCPUSequencer();
             if (seq != NULL) {
+                // materialize any deferred samples before reading them
+                seq->collateStats();
                 m_outstandReqHistSeqr.add(seq->getOutstandReqHist());
             }
 #ifdef BUILD_GPU
@@ -58,6 +58,7 @@
 #include "mem/ruby/common/MachineID.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubyController.hh"
 
 class Network;
@@ -99,6 +100,12 @@ class AbstractController : public MemObject, public Consumer
     virtual void regStats();
 
     virtual void recordCacheTrace(int cntrl, CacheRecorder* tr) = 0;
+    //! Save / restore the exact state of the controller's caches and
+    //! directory, see CacheSnapshot. Protocols whose entries cannot be
+    //! stored, e.g. those with a WriteMask, give the reason instead.
+    virtual const char *cacheSnapshotProblem() const = 0;
+    virtual void saveCacheSnapshot(CacheSnapshot &snap) = 0;
+    virtual void loadCacheSnapshot(CacheSnapshot &snap) = 0;
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
 
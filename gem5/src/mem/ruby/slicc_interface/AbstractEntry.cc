@@ -28,6 +28,8 @@
 
 #include "mem/ruby/slicc_interface/AbstractEntry.hh"
 
+#include "base/logging.hh"
+
 AbstractEntry::AbstractEntry()
 {
     m_Permission = AccessPermission_NotPresent;
@@ -48,3 +50,15 @@ AbstractEntry::changePermission(AccessPermission new_perm)
 {
     m_Permission = new_perm;
 }
+
+void
+AbstractEntry::saveSnapshot(CacheSnapshot &snap) const
+{
+    fatal("Cache snapshots are not supported by this protocol's entries");
+}
+
+void
+AbstractEntry::loadSnapshot(CacheSnapshot &snap)
+{
+    fatal("Cache snapshots are not supported by this protocol's entries");
+}
@@ -33,6 +33,8 @@
 
 #include "mem/protocol/AccessPermission.hh"
 
+class CacheSnapshot;
+
 class AbstractEntry
 {
   public:
@@ -45,6 +47,11 @@ class AbstractEntry
 
     virtual void print(std::ostream& out) const = 0;
 
+    // Write the entry's state to / read it back from a cache snapshot.
+    // SLICC generates these for entries whose fields can be stored.
+    virtual void saveSnapshot(CacheSnapshot &snap) const;
+    virtual void loadSnapshot(CacheSnapshot &snap);
+
     AccessPermission m_Permission; // Access permission for this
                                    // block, required by CacheMemory
 };
@@ -36,10 +36,24 @@
 #include "mem/packet.hh"
 #include "mem/protocol/MessageSizeType.hh"
 #include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/PoolAllocator.hh"
 
 class Message;
 typedef std::shared_ptr<Message> MsgPtr;
 
+/**
+ * Allocate a message of type T from the pool of that type. Messages are
+ * created and destroyed at a high rate, so they are recycled rather than
+ * going back to the heap every time.
+ */
+template <class T, class... Args>
+inline std::shared_ptr<T>
+makeMessage(Args&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>(),
+                                   std::forward<Args>(args)...);
+}
+
 class Message
 {
   public:
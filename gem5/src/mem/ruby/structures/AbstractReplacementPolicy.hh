@@ -46,6 +46,18 @@ class AbstractReplacementPolicy : public SimObject
     /* touch a block. a.k.a. update timestamp */
     virtual void touch(int64_t set, int64_t way, Tick time) = 0;
 
+    /* reset a block when it is (re)allocated, defaults to a touch */
+    virtual void reset(int64_t set, int64_t way, Tick time)
+    { touch(set, way, time); }
+
+    /* refill a block from a cache snapshot with the time it was last
+     * accessed, defaults to a reset at that time */
+    virtual void restore(int64_t set, int64_t way, Tick time)
+    { reset(set, way, time); }
+
+    /* invalidate a block when it is deallocated */
+    virtual void invalidate(int64_t set, int64_t way) {}
+
     /* returns the way to replace */
     virtual int64_t getVictim(int64_t set) const = 0;
 
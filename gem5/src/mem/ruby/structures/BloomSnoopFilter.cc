@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/BloomSnoopFilter.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "debug/RubySlicc.hh"
+#include "mem/ruby/filters/BlockBloomFilter.hh"
+#include "mem/ruby/filters/BulkBloomFilter.hh"
+#include "mem/ruby/filters/H3BloomFilter.hh"
+#include "mem/ruby/filters/LSB_CountingBloomFilter.hh"
+#include "mem/ruby/filters/MultiGrainBloomFilter.hh"
+#include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
+
+using namespace std;
+
+BloomSnoopFilter *
+RubyBloomSnoopFilterParams::create()
+{
+    return new BloomSnoopFilter(this);
+}
+
+BloomSnoopFilter::BloomSnoopFilter(const Params *p)
+    : SimObject(p), m_filter_type(p->filter_type),
+      m_filter_size(p->filter_size), m_num_hashes(p->num_hashes),
+      m_max_count(p->max_count),
+      m_counting(p->filter_type == "LSB_Counting"),
+      m_track_false_positives(p->track_false_positives),
+      m_machine_type(MachineType_NUM)
+{
+    fatal_if(!isPowerOf2(m_filter_size),
+             "%s: filter_size must be a power of two\n", name());
+    fatal_if(m_filter_type == "H3" &&
+             (m_num_hashes < 1 || m_num_hashes > 6),
+             "%s: H3 filters support 1 to 6 hashes\n", name());
+    fatal_if(m_counting && !isPowerOf2(m_max_count + 1),
+             "%s: max_count must be one less than a power of two\n",
+             name());
+
+    // Build one filter up front so a bad filter_type fails at startup.
+    delete makeFilter();
+}
+
+BloomSnoopFilter::~BloomSnoopFilter()
+{
+}
+
+AbstractBloomFilter *
+BloomSnoopFilter::makeFilter() const
+{
+    if (m_filter_type == "H3") {
+        return new H3BloomFilter(m_filter_size, m_num_hashes, false);
+    } else if (m_filter_type == "Bulk") {
+        return new BulkBloomFilter(m_filter_size);
+    } else if (m_filter_type == "Block") {
+        return new BlockBloomFilter(m_filter_size);
+    } else if (m_filter_type == "MultiGrain") {
+        return new MultiGrainBloomFilter(m_filter_size, m_filter_size);
+    } else if (m_filter_type == "LSB_Counting") {
+        return new LSB_CountingBloomFilter(m_filter_size, m_max_count);
+    }
+    fatal("%s: unknown snoop filter type '%s'\n", name(), m_filter_type);
+}
+
+BloomSnoopFilter::Node &
+BloomSnoopFilter::node(MachineID machine)
+{
+    if (m_machine_type == MachineType_NUM) {
+        m_machine_type = machine.getType();
+        m_nodes.resize(MachineType_base_count(m_machine_type));
+    }
+    fatal_if(machine.getType() != m_machine_type,
+             "%s: cannot track %s and %s caches in one snoop filter\n",
+             name(), MachineType_to_string(m_machine_type),
+             MachineType_to_string(machine.getType()));
+
+    Node &n = m_nodes[machineIDToNodeID(machine)];
+    if (!n.filter)
+        n.filter.reset(makeFilter());
+    return n;
+}
+
+bool
+BloomSnoopFilter::mayHold(Node &n, Addr addr) const
+{
+    if (!n.filter)
+        return false;
+    return m_counting ? n.filter->getCount(addr) > 0
+                      : n.filter->isSet(addr);
+}
+
+void
+BloomSnoopFilter::addSharer(Addr addr, MachineID machine)
+{
+    Node &n = node(machine);
+    if (m_counting)
+        n.filter->increment(addr);
+    else
+        n.filter->set(addr);
+
+    if (m_track_false_positives)
+        n.lines.insert(makeLineAddress(addr));
+}
+
+void
+BloomSnoopFilter::removeSharer(Addr addr, MachineID machine)
+{
+    Node &n = node(machine);
+    if (m_counting) {
+        if (n.filter->getCount(addr) >= m_max_count)
+            m_saturated_removes++;
+        else
+            n.filter->decrement(addr);
+    }
+
+    if (m_track_false_positives)
+        n.lines.erase(makeLineAddress(addr));
+}
+
+Set
+BloomSnoopFilter::getSharers(Addr addr, MachineID requestor)
+{
+    const MachineType type = requestor.getType();
+    const int count = MachineType_base_count(type);
+    Set sharers(count);
+
+    m_lookups++;
+    if (type != m_machine_type) {
+        // Nothing of this type was ever recorded.
+        m_probes_filtered += count - 1;
+        return sharers;
+    }
+
+    const Addr line = makeLineAddress(addr);
+    const NodeID self = machineIDToNodeID(requestor);
+    for (NodeID i = 0; i < count; i++) {
+        if (i == self)
+            continue;
+        Node &n = m_nodes[i];
+        if (mayHold(n, addr)) {
+            sharers.add(i);
+            m_probes_sent++;
+            if (m_track_false_positives && !n.lines.count(line))
+                m_false_positives++;
+        } else {
+            m_probes_filtered++;
+        }
+    }
+
+    DPRINTF(RubySlicc, "%s: sharers of %#x = %s\n", name(), addr, sharers);
+    return sharers;
+}
+
+void
+BloomSnoopFilter::print(ostream& out) const
+{
+    out << "[BloomSnoopFilter " << m_filter_type << " size "
+        << m_filter_size << "]";
+}
+
+void
+BloomSnoopFilter::regStats()
+{
+    SimObject::regStats();
+
+    m_lookups
+        .name(name() + ".lookups")
+        .desc("Number of snoop filter lookups")
+        ;
+
+    m_probes_sent
+        .name(name() + ".probes_sent")
+        .desc("Number of caches probed after filtering")
+        ;
+
+    m_probes_filtered
+        .name(name() + ".probes_filtered")
+        .desc("Number of probes a broadcast would have sent that were "
+              "filtered out")
+        ;
+
+    m_false_positives
+        .name(name() + ".false_positives")
+        .desc("Number of probes sent to caches that never received the "
+              "line (only with track_false_positives)")
+        ;
+
+    m_saturated_removes
+        .name(name() + ".saturated_removes")
+        .desc("Number of removals ignored because the counter saturated")
+        ;
+
+    m_filter_rate
+        .name(name() + ".filter_rate")
+        .desc("Fraction of broadcast probes filtered out")
+        ;
+    m_filter_rate = m_probes_filtered / (m_probes_sent + m_probes_filtered);
+}
+
+ostream&
+operator<<(ostream& out, const BloomSnoopFilter& obj)
+{
+    obj.print(out);
+    out << flush;
+    return out;
+}
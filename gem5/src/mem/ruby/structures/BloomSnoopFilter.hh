@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_BLOOMSNOOPFILTER_HH__
+#define __MEM_RUBY_STRUCTURES_BLOOMSNOOPFILTER_HH__
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/protocol/MachineType.hh"
+#include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/common/Set.hh"
+#include "mem/ruby/filters/AbstractBloomFilter.hh"
+#include "params/RubyBloomSnoopFilter.hh"
+#include "sim/sim_object.hh"
+
+/*!
+ * A directory-side snoop filter that keeps one Bloom filter per cache.
+ * Instead of broadcasting a probe to every cache, the directory probes
+ * only the caches whose filter may hold the line. A Bloom filter never
+ * reports a false negative, so a cache that holds the line is always
+ * probed; a false positive only costs the probe the broadcast would have
+ * sent anyway.
+ *
+ * Plain Bloom filters cannot forget a line, so with them a cache stays a
+ * candidate sharer until the filter is cleared. The LSB_Counting filter
+ * counts insertions and is decremented when a cache writes a line back.
+ * A counter that saturates at max_count is never decremented again, as
+ * it no longer knows how many lines alias to it.
+ */
+class BloomSnoopFilter : public SimObject
+{
+  public:
+    typedef RubyBloomSnoopFilterParams Params;
+    BloomSnoopFilter(const Params *p);
+    ~BloomSnoopFilter();
+
+    void regStats() override;
+
+    /** Record that a cache may now hold the line. */
+    void addSharer(Addr addr, MachineID node);
+
+    /** Record that a cache gave up the line. */
+    void removeSharer(Addr addr, MachineID node);
+
+    /**
+     * Caches of the requestor's type that may hold the line, excluding
+     * the requestor itself. Counts one snoop lookup.
+     */
+    Set getSharers(Addr addr, MachineID requestor);
+
+    void print(std::ostream& out) const;
+
+  private:
+    struct Node
+    {
+        std::unique_ptr<AbstractBloomFilter> filter;
+        // Exact shadow of the lines the filter was told about, used to
+        // classify false positives. Never consulted for filtering.
+        std::unordered_set<Addr> lines;
+    };
+
+    AbstractBloomFilter *makeFilter() const;
+    Node &node(MachineID machine);
+    bool mayHold(Node &n, Addr addr) const;
+
+    const std::string m_filter_type;
+    const int m_filter_size;
+    const int m_num_hashes;
+    const int m_max_count;
+    const bool m_counting;
+    const bool m_track_false_positives;
+
+    // One filter per cache, indexed by NodeID. All tracked caches are
+    // of the same machine type.
+    MachineType m_machine_type;
+    std::vector<Node> m_nodes;
+
+    Stats::Scalar m_lookups;
+    Stats::Scalar m_probes_sent;
+    Stats::Scalar m_probes_filtered;
+    Stats::Scalar m_false_positives;
+    Stats::Scalar m_saturated_removes;
+    Stats::Formula m_filter_rate;
+};
+
+std::ostream& operator<<(std::ostream& out, const BloomSnoopFilter& obj);
+
+#endif // __MEM_RUBY_STRUCTURES_BLOOMSNOOPFILTER_HH__
@@ -0,0 +1,45 @@
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+class RubyBloomSnoopFilter(SimObject):
+    type = 'RubyBloomSnoopFilter'
+    cxx_class = 'BloomSnoopFilter'
+    cxx_header = "mem/ruby/structures/BloomSnoopFilter.hh"
+
+    filter_type = Param.String("H3", "Bloom filter used per cache: H3, "
+                               "Bulk, Block, MultiGrain or LSB_Counting")
+    filter_size = Param.Int(4096, "entries per cache filter (power of 2)")
+    num_hashes = Param.Int(4, "number of hash functions (H3 only, max 6)")
+    max_count = Param.Int(15, "saturation value of a counter "
+                          "(LSB_Counting only)")
+    # The shadow is an exact set of the cached lines, unbounded unlike
+    # the filters, so it is only worth its memory for the
+    # false_positives stat
+    track_false_positives = Param.Bool(False, "keep an exact shadow of "
+                                       "each filter to count false positives")
@@ -30,8 +30,8 @@
 #ifndef __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
+#include <functional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -44,6 +44,7 @@
 #include "mem/ruby/structures/AbstractReplacementPolicy.hh"
 #include "mem/ruby/structures/BankedArray.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
 
@@ -104,6 +105,12 @@ class CacheMemory : public SimObject
     // Hook for checkpointing the contents of the cache
     void recordCacheContents(int cntrl, CacheRecorder* tr) const;
 
+    // Write the exact cache contents to a snapshot, or refill the cache
+    // from one. make_entry creates an empty entry of the protocol's type.
+    void saveSnapshot(CacheSnapshot &snap) const;
+    void loadSnapshot(CacheSnapshot &snap,
+                      const std::function<AbstractCacheEntry *()> &make_entry);
+
     // Set this address to most recently used
     void setMRU(Addr address);
     void setMRU(Addr addr, int occupancy);
@@ -160,6 +167,19 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Flat index of a (set, way) pair in m_tags and m_cache
+    int64_t
+    wayIndex(int64_t cacheSet, int way) const
+    {
+        return cacheSet * m_cache_assoc + way;
+    }
+
+    AbstractCacheEntry*
+    entryAt(int64_t cacheSet, int way) const
+    {
+        return m_cache[wayIndex(cacheSet, way)];
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -168,10 +188,12 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Both arrays are indexed by set * m_cache_assoc + way, so the ways of
+    // a set are contiguous. m_tags holds the line address of each way (or
+    // MaxAddr when the way is unused) and is what lookups scan, leaving the
+    // entries themselves untouched until a tag matches.
+    std::vector<Addr> m_tags;
+    std::vector<AbstractCacheEntry*> m_cache;
 
     AbstractReplacementPolicy *m_replacementPolicy_ptr;
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/ClassicPolicy.hh"
+
+#include "base/logging.hh"
+
+ClassicPolicy::ClassicPolicy(const Params * p)
+    : AbstractReplacementPolicy(p), m_policy(p->replacement_policy),
+      m_entries(m_num_sets * m_assoc), m_candidates(m_num_sets)
+{
+    fatal_if(m_policy == nullptr,
+             "%s: a classic replacement policy must be provided", name());
+
+    for (unsigned i = 0; i < m_num_sets; i++) {
+        m_candidates[i].reserve(m_assoc);
+        for (unsigned j = 0; j < m_assoc; j++) {
+            ReplaceableEntry &e = m_entries[i * m_assoc + j];
+            e.replacementData = m_policy->instantiateEntry();
+            m_policy->invalidate(e.replacementData);
+            m_candidates[i].push_back(&e);
+        }
+    }
+}
+
+ClassicPolicy::~ClassicPolicy()
+{
+}
+
+ClassicPolicy *
+ClassicReplacementPolicyParams::create()
+{
+    return new ClassicPolicy(this);
+}
+
+ReplaceableEntry&
+ClassicPolicy::entry(int64_t set, int64_t way)
+{
+    assert(way >= 0 && way < m_assoc);
+    assert(set >= 0 && set < m_num_sets);
+
+    return m_entries[set * m_assoc + way];
+}
+
+void
+ClassicPolicy::touch(int64_t set, int64_t way, Tick time)
+{
+    m_last_ref_ptr[set][way] = time;
+    m_policy->touch(entry(set, way).replacementData);
+}
+
+void
+ClassicPolicy::reset(int64_t set, int64_t way, Tick time)
+{
+    m_last_ref_ptr[set][way] = time;
+    m_policy->reset(entry(set, way).replacementData);
+}
+
+void
+ClassicPolicy::restore(int64_t set, int64_t way, Tick time)
+{
+    // Keep the recency order, state beyond recency (LFU counts, RRIP
+    // values) restarts from the insertion state
+    m_last_ref_ptr[set][way] = time;
+    m_policy->restore(entry(set, way).replacementData, time);
+}
+
+void
+ClassicPolicy::invalidate(int64_t set, int64_t way)
+{
+    m_last_ref_ptr[set][way] = 0;
+    m_policy->invalidate(entry(set, way).replacementData);
+}
+
+int64_t
+ClassicPolicy::getVictim(int64_t set) const
+{
+    assert(set >= 0 && set < m_num_sets);
+
+    const ReplaceableEntry *victim = m_policy->getVictim(m_candidates[set]);
+    int64_t way = victim - &m_entries[set * m_assoc];
+    assert(way >= 0 && way < m_assoc);
+
+    return way;
+}
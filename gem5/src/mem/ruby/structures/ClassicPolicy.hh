@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_CLASSICPOLICY_HH__
+#define __MEM_RUBY_STRUCTURES_CLASSICPOLICY_HH__
+
+#include <vector>
+
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/ruby/structures/AbstractReplacementPolicy.hh"
+#include "params/ClassicReplacementPolicy.hh"
+
+/**
+ * Adapter that lets a Ruby CacheMemory use any of the classic
+ * BaseReplacementPolicy objects (LRURP, LFURP, BRRIPRP, EnergyAwareRP...).
+ *
+ * Every (set, way) pair owns a ReplaceableEntry whose replacement data is
+ * instantiated by the wrapped policy. A victim is chosen by handing the
+ * entries of a set to the policy as its replacement candidates, which is
+ * the same per-set view the classic tags give it.
+ */
+class ClassicPolicy : public AbstractReplacementPolicy
+{
+  public:
+    typedef ClassicReplacementPolicyParams Params;
+    ClassicPolicy(const Params * p);
+    ~ClassicPolicy();
+
+    void touch(int64_t set, int64_t way, Tick time);
+    void reset(int64_t set, int64_t way, Tick time);
+    void restore(int64_t set, int64_t way, Tick time);
+    void invalidate(int64_t set, int64_t way);
+    int64_t getVictim(int64_t set) const;
+
+  private:
+    ReplaceableEntry& entry(int64_t set, int64_t way);
+
+    /** The wrapped classic replacement policy */
+    BaseReplacementPolicy *m_policy;
+
+    /** Replaceable entries, m_assoc contiguous ways per set */
+    std::vector<ReplaceableEntry> m_entries;
+
+    /** Per-set candidate lists handed to the wrapped policy */
+    std::vector<ReplacementCandidates> m_candidates;
+};
+
+#endif // __MEM_RUBY_STRUCTURES_CLASSICPOLICY_HH__
@@ -140,6 +140,48 @@ DirectoryMemory::print(ostream& out) const
 {
 }
 
+void
+DirectoryMemory::saveSnapshot(CacheSnapshot &snap) const
+{
+    snap.putTag(name());
+    snap.put(m_num_entries);
+
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < m_num_entries; i++) {
+        if (m_entries[i] != NULL)
+            count++;
+    }
+    snap.put(count);
+
+    for (uint64_t i = 0; i < m_num_entries; i++) {
+        if (m_entries[i] != NULL) {
+            snap.put(i);
+            m_entries[i]->saveSnapshot(snap);
+        }
+    }
+}
+
+void
+DirectoryMemory::loadSnapshot(CacheSnapshot &snap,
+                              const function<AbstractEntry *()> &make_entry)
+{
+    snap.checkTag(name());
+    uint64_t num_entries, count;
+    snap.get(num_entries);
+    fatal_if(num_entries != m_num_entries, "%s: snapshot has %d entries, "
+             "directory has %d\n", name(), num_entries, m_num_entries);
+
+    snap.get(count);
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t idx;
+        snap.get(idx);
+        assert(idx < m_num_entries);
+        delete m_entries[idx];
+        m_entries[idx] = make_entry();
+        m_entries[idx]->loadSnapshot(snap);
+    }
+}
+
 void
 DirectoryMemory::recordRequestType(DirectoryRequestType requestType) {
     DPRINTF(RubyStats, "Recorded statistic: %s\n",
@@ -41,6 +41,7 @@
 #ifndef __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -48,6 +49,7 @@
 #include "mem/protocol/DirectoryRequestType.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/slicc_interface/AbstractEntry.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubyDirectoryMemory.hh"
 #include "sim/sim_object.hh"
 
@@ -82,6 +84,12 @@ class DirectoryMemory : public SimObject
     void print(std::ostream& out) const;
     void recordRequestType(DirectoryRequestType requestType);
 
+    // Write the allocated entries to a snapshot, or refill the directory
+    // from one. make_entry creates an empty entry of the protocol's type.
+    void saveSnapshot(CacheSnapshot &snap) const;
+    void loadSnapshot(CacheSnapshot &snap,
+                      const std::function<AbstractEntry *()> &make_entry);
+
   private:
     // Private copy constructor and assignment operator
     DirectoryMemory(const DirectoryMemory& obj);
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/system/CacheSnapshot.hh"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cassert>
+
+#include "base/logging.hh"
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/Set.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+using namespace std;
+
+CacheSnapshot::CacheSnapshot()
+    : m_file(NULL)
+{
+}
+
+CacheSnapshot::CacheSnapshot(const string &filename)
+    : m_filename(filename), m_file(NULL)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        fatal("Unable to open cache snapshot %s", filename);
+    }
+
+    m_file = gzdopen(fd, "rb");
+    if (m_file == NULL) {
+        fatal("Insufficient memory to allocate compression state for %s\n",
+              filename);
+    }
+
+    // Decompress in large chunks, restores are meant to be I/O bound.
+    gzbuffer(m_file, 1 << 20);
+}
+
+CacheSnapshot::~CacheSnapshot()
+{
+    if (m_file != NULL && gzclose(m_file)) {
+        fatal("Failed to close cache snapshot '%s'\n", m_filename);
+    }
+}
+
+void
+CacheSnapshot::save(const string &filename) const
+{
+    int fd = creat(filename.c_str(), 0664);
+    if (fd < 0) {
+        perror("creat");
+        fatal("Can't open cache snapshot '%s'\n", filename);
+    }
+
+    gzFile file = gzdopen(fd, "wb");
+    if (file == NULL)
+        fatal("Insufficient memory to allocate compression state for %s\n",
+              filename);
+
+    // gzwrite() takes an unsigned length, write large images in pieces.
+    const size_t chunk = 1 << 30;
+    for (size_t pos = 0; pos < m_data.size(); pos += chunk) {
+        unsigned len = min(chunk, m_data.size() - pos);
+        if (gzwrite(file, &m_data[pos], len) != len) {
+            fatal("Write failed on cache snapshot '%s'\n", filename);
+        }
+    }
+
+    if (gzclose(file)) {
+        fatal("Close failed on cache snapshot '%s'\n", filename);
+    }
+}
+
+void
+CacheSnapshot::putBytes(const void *data, size_t len)
+{
+    assert(m_file == NULL);
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    m_data.insert(m_data.end(), bytes, bytes + len);
+}
+
+void
+CacheSnapshot::getBytes(void *data, size_t len)
+{
+    assert(m_file != NULL);
+    if (gzread(m_file, data, len) != (int)len) {
+        fatal("Cache snapshot '%s' is truncated\n", m_filename);
+    }
+}
+
+void
+CacheSnapshot::put(const string &str)
+{
+    put<uint32_t>(str.size());
+    putBytes(str.data(), str.size());
+}
+
+void
+CacheSnapshot::get(string &str)
+{
+    uint32_t len;
+    get(len);
+    str.resize(len);
+    if (len > 0)
+        getBytes(&str[0], len);
+}
+
+void
+CacheSnapshot::put(const DataBlock &blk)
+{
+    uint32_t size = RubySystem::getBlockSizeBytes();
+    putBytes(blk.getData(0, size), size);
+}
+
+void
+CacheSnapshot::get(DataBlock &blk)
+{
+    getBytes(blk.getDataMod(0), RubySystem::getBlockSizeBytes());
+}
+
+void
+CacheSnapshot::put(const NetDest &dest)
+{
+    // Store the members rather than the bit vectors, the latter are sized
+    // by the machine counts and cheap to rebuild.
+    vector<MachineID> members;
+    for (int m = 0; m < MachineType_NUM; m++) {
+        MachineType type = static_cast<MachineType>(m);
+        for (NodeID n = 0; n < MachineType_base_count(type); n++) {
+            MachineID id(type, n);
+            if (dest.isElement(id))
+                members.push_back(id);
+        }
+    }
+
+    put<uint32_t>(members.size());
+    for (const auto &id : members)
+        put(id);
+}
+
+void
+CacheSnapshot::get(NetDest &dest)
+{
+    uint32_t count;
+    get(count);
+    dest.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        MachineID id;
+        get(id);
+        dest.add(id);
+    }
+}
+
+void
+CacheSnapshot::put(const Set &set)
+{
+    put<int32_t>(set.getSize());
+    put<int32_t>(set.count());
+    for (NodeID n = 0; n < set.getSize(); n++) {
+        if (set.isElement(n))
+            put(n);
+    }
+}
+
+void
+CacheSnapshot::get(Set &set)
+{
+    int32_t size, count;
+    get(size);
+    get(count);
+    set.setSize(size);
+    set.clear();
+    for (int32_t i = 0; i < count; i++) {
+        NodeID n;
+        get(n);
+        set.add(n);
+    }
+}
+
+void
+CacheSnapshot::checkTag(const string &tag)
+{
+    string found;
+    get(found);
+    fatal_if(found != tag, "Cache snapshot '%s' does not match the "
+             "configuration: expected '%s', found '%s'\n", m_filename, tag,
+             found);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * A compact, streamed image of the Ruby cache and directory state, used
+ * to restore a checkpoint by writing the state straight back into the
+ * structures instead of replaying the cache trace.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
+#define __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
+
+#include <zlib.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base/types.hh"
+
+class DataBlock;
+class NetDest;
+class Set;
+
+/*!
+ * A snapshot is either built in memory while the caches are recorded
+ * (the writer) or read from a checkpoint file (the reader). The reader
+ * decompresses the file in large chunks as the structures pull their
+ * state from it, so a restore never holds the whole image in memory.
+ *
+ * The stream carries no type information. Every structure reads its
+ * state back in exactly the order it wrote it, and records its geometry
+ * first so mismatching configurations are caught early.
+ *
+ * Only the field types the encoding knows about can be stored. SLICC
+ * marks the controllers whose entries hold anything else (e.g. the
+ * WriteMask of the GPU protocols) and RubySystem refuses to use
+ * snapshots with them.
+ */
+class CacheSnapshot
+{
+  public:
+    //! Create an empty snapshot to be filled in and saved
+    CacheSnapshot();
+    //! Open a saved snapshot for reading
+    CacheSnapshot(const std::string &filename);
+    ~CacheSnapshot();
+
+    //! Compress the recorded snapshot into the given file
+    void save(const std::string &filename) const;
+
+    void putBytes(const void *data, size_t len);
+    void getBytes(void *data, size_t len);
+
+    template <class T>
+    void
+    put(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "No snapshot encoding for this type");
+        putBytes(&value, sizeof(T));
+    }
+
+    template <class T>
+    void
+    get(T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "No snapshot encoding for this type");
+        getBytes(&value, sizeof(T));
+    }
+
+    void put(const std::string &str);
+    void get(std::string &str);
+    void put(const DataBlock &blk);
+    void get(DataBlock &blk);
+    void put(const NetDest &dest);
+    void get(NetDest &dest);
+    void put(const Set &set);
+    void get(Set &set);
+
+    /*!
+     * Write a tag and check it when reading back, to detect a snapshot
+     * that does not match the structure restoring from it.
+     */
+    void putTag(const std::string &tag) { put(tag); }
+    void checkTag(const std::string &tag);
+
+  private:
+    // Private copy constructor and assignment operator
+    CacheSnapshot(const CacheSnapshot& obj);
+    CacheSnapshot& operator=(const CacheSnapshot& obj);
+
+    std::string m_filename;
+    //! Snapshot being recorded
+    std::vector<uint8_t> m_data;
+    //! Snapshot being read
+    gzFile m_file;
+};
+
+#endif // __MEM_RUBY_SYSTEM_CACHESNAPSHOT_HH__
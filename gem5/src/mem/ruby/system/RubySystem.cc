@@ -58,7 +58,8 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params *p)
     : ClockedObject(p), m_access_backing_store(p->access_backing_store),
-      m_cache_recorder(NULL)
+      m_use_cache_snapshot(p->cache_snapshot),
+      m_cache_recorder(NULL), m_cache_snapshot(NULL)
 {
     m_randomization = p->randomization;
 
@@ -144,6 +145,12 @@ RubySystem::memWriteback()
     }
     DPRINTF(RubyCacheTrace, "Cache Trace Complete\n");
 
+    // The flush below changes the cache contents, take the snapshot of
+    // the state to restore first.
+    if (m_use_cache_snapshot) {
+        makeCacheSnapshot();
+    }
+
     // save the current tick value
     Tick curtick_original = curTick();
     DPRINTF(RubyCacheTrace, "Recording current tick %ld\n", curtick_original);
@@ -203,6 +210,45 @@ RubySystem::memWriteback()
     // checkpoint is immediately taken.
 }
 
+void
+RubySystem::makeCacheSnapshot()
+{
+    delete m_cache_snapshot;
+    m_cache_snapshot = new CacheSnapshot();
+
+    m_cache_snapshot->putTag("ruby-cache-snapshot-v1");
+    m_cache_snapshot->put(getBlockSizeBytes());
+    for (auto cntrl : m_abs_cntrl_vec) {
+        m_cache_snapshot->putTag(cntrl->name());
+        cntrl->saveCacheSnapshot(*m_cache_snapshot);
+    }
+}
+
+void
+RubySystem::restoreCacheSnapshot(const string &filename)
+{
+    DPRINTF(RubyCacheTrace, "Restoring cache state from %s\n", filename);
+
+    // Unlike the cache trace, the snapshot is read straight into the
+    // caches and directories. No requests are replayed, so neither the
+    // clock nor the event queue need to be touched.
+    CacheSnapshot snap(filename);
+    snap.checkTag("ruby-cache-snapshot-v1");
+    uint32_t block_size_bytes;
+    snap.get(block_size_bytes);
+    fatal_if(block_size_bytes != getBlockSizeBytes(),
+             "Cache snapshot block size (%d) != current block size (%d), "
+             "restore from the cache trace instead\n", block_size_bytes,
+             getBlockSizeBytes());
+
+    for (auto cntrl : m_abs_cntrl_vec) {
+        snap.checkTag(cntrl->name());
+        cntrl->loadCacheSnapshot(snap);
+    }
+
+    DPRINTF(RubyCacheTrace, "Cache state restored\n");
+}
+
 void
 RubySystem::writeCompressedTrace(uint8_t *raw_data, string filename,
                                  uint64_t uncompressed_trace_size)
@@ -257,6 +303,13 @@ RubySystem::serialize(CheckpointOut &cp) const
 
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
+
+    if (m_cache_snapshot) {
+        string cache_snapshot_file = name() + ".cache_state.gz";
+        m_cache_snapshot->save(CheckpointIn::dir() + "/" +
+                               cache_snapshot_file);
+        SERIALIZE_SCALAR(cache_snapshot_file);
+    }
 }
 
 void
@@ -268,6 +321,9 @@ RubySystem::drainResume()
         delete m_cache_recorder;
         m_cache_recorder = NULL;
     }
+
+    delete m_cache_snapshot;
+    m_cache_snapshot = NULL;
 }
 
 void
@@ -312,6 +368,15 @@ RubySystem::unserialize(CheckpointIn &cp)
     uint64_t block_size_bytes = getBlockSizeBytes();
     UNSERIALIZE_OPT_SCALAR(block_size_bytes);
 
+    if (m_use_cache_snapshot) {
+        string cache_snapshot_file;
+        if (UNSERIALIZE_OPT_SCALAR(cache_snapshot_file)) {
+            restoreCacheSnapshot(cp.cptDir + "/" + cache_snapshot_file);
+            return;
+        }
+        warn("Checkpoint has no cache snapshot, replaying the cache trace\n");
+    }
+
     string cache_trace_file;
     uint64_t cache_trace_size = 0;
 
@@ -331,6 +396,15 @@ RubySystem::unserialize(CheckpointIn &cp)
 void
 RubySystem::startup()
 {
+    // Refuse protocols that cannot be snapshotted now rather than when the
+    // first checkpoint is taken.
+    if (m_use_cache_snapshot) {
+        for (auto cntrl : m_abs_cntrl_vec) {
+            const char *problem = cntrl->cacheSnapshotProblem();
+            fatal_if(problem, "%s: cache_snapshot is not supported by %s, "
+                     "%s\n", name(), cntrl->name(), problem);
+        }
+    }
 
     // Ruby restores state from a checkpoint by resetting the clock to 0 and
     // playing the requests that can possibly re-generate the cache state.
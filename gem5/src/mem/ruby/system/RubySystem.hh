@@ -41,6 +41,7 @@
 #include "mem/ruby/profiler/Profiler.hh"
 #include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
+#include "mem/ruby/system/CacheSnapshot.hh"
 #include "params/RubySystem.hh"
 #include "sim/clocked_object.hh"
 
@@ -116,6 +117,9 @@ class RubySystem : public ClockedObject
     static void writeCompressedTrace(uint8_t *raw_data, std::string file,
                                      uint64_t uncompressed_trace_size);
 
+    void makeCacheSnapshot();
+    void restoreCacheSnapshot(const std::string &filename);
+
     void processRubyEvent();
   private:
     // configuration parameters
@@ -129,6 +133,7 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_use_cache_snapshot;
 
     Network* m_network;
     std::vector<AbstractController *> m_abs_cntrl_vec;
@@ -137,6 +142,7 @@ class RubySystem : public ClockedObject
   public:
     Profiler* m_profiler;
     CacheRecorder* m_cache_recorder;
+    CacheSnapshot* m_cache_snapshot;
     std::vector<std::map<uint32_t, AbstractController *> > m_abstract_controls;
 };
 
@@ -46,6 +46,12 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    cache_snapshot = Param.Bool(False, "Checkpoint the exact cache and \
+        directory state and restore it by writing it straight back into \
+        the caches, rather than replaying the cache trace. Not supported \
+        by protocols with entry fields that cannot be stored, e.g. the \
+        WriteMask of the GPU protocols.")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -28,6 +28,9 @@
 
 #include "mem/ruby/system/Sequencer.hh"
 
+#include <algorithm>
+#include <limits>
+
 #include "arch/x86/ldstflags.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
@@ -74,6 +77,10 @@ Sequencer::Sequencer(const Params *p)
     assert(m_inst_cache_hit_latency > 0);
 
     m_runningGarnetStandalone = p->garnet_standalone;
+    m_lightweightStats = p->lightweight_latency_stats;
+
+    m_writeRequestTable.init(m_max_outstanding_requests);
+    m_readRequestTable.init(m_max_outstanding_requests);
 }
 
 Sequencer::~Sequencer()
@@ -91,12 +98,9 @@ Sequencer::wakeup()
     // Check across all outstanding requests
     int total_outstanding = 0;
 
-    RequestTable::iterator read = m_readRequestTable.begin();
-    RequestTable::iterator read_end = m_readRequestTable.end();
-    for (; read != read_end; ++read) {
-        SequencerRequest* request = read->second;
+    m_readRequestTable.forEach([&](Addr line, SequencerRequest* request) {
         if (current_time - request->issue_time < m_deadlock_threshold)
-            continue;
+            return;
 
         panic("Possible Deadlock detected. Aborting!\n"
               "version: %d request.paddr: 0x%x m_readRequestTable: %d "
@@ -104,14 +108,11 @@ Sequencer::wakeup()
               request->pkt->getAddr(), m_readRequestTable.size(),
               current_time * clockPeriod(), request->issue_time * clockPeriod(),
               (current_time * clockPeriod()) - (request->issue_time * clockPeriod()));
-    }
+    });
 
-    RequestTable::iterator write = m_writeRequestTable.begin();
-    RequestTable::iterator write_end = m_writeRequestTable.end();
-    for (; write != write_end; ++write) {
-        SequencerRequest* request = write->second;
+    m_writeRequestTable.forEach([&](Addr line, SequencerRequest* request) {
         if (current_time - request->issue_time < m_deadlock_threshold)
-            continue;
+            return;
 
         panic("Possible Deadlock detected. Aborting!\n"
               "version: %d request.paddr: 0x%x m_writeRequestTable: %d "
@@ -119,7 +120,7 @@ Sequencer::wakeup()
               request->pkt->getAddr(), m_writeRequestTable.size(),
               current_time * clockPeriod(), request->issue_time * clockPeriod(),
               (current_time * clockPeriod()) - (request->issue_time * clockPeriod()));
-    }
+    });
 
     total_outstanding += m_writeRequestTable.size();
     total_outstanding += m_readRequestTable.size();
@@ -132,34 +133,81 @@ Sequencer::wakeup()
     }
 }
 
-void Sequencer::resetStats()
+void
+DeferredHistogram::flush()
 {
-    m_latencyHist.reset();
-    m_hitLatencyHist.reset();
-    m_missLatencyHist.reset();
+    if (pending.empty())
+        return;
+
+    const uint64_t max_chunk = std::numeric_limits<int>::max();
+    for (uint64_t value = 0; value < MaxDeferred; value++) {
+        uint64_t count = pending[value];
+        while (count) {
+            int n = std::min(count, max_chunk);
+            sample(value, n);
+            count -= n;
+        }
+    }
+    pending.clear();
+}
+
+template <class F>
+void
+Sequencer::forEachLatencyHist(F f)
+{
+    f(m_latencyHist);
+    f(m_hitLatencyHist);
+    f(m_missLatencyHist);
     for (int i = 0; i < RubyRequestType_NUM; i++) {
-        m_typeLatencyHist[i]->reset();
-        m_hitTypeLatencyHist[i]->reset();
-        m_missTypeLatencyHist[i]->reset();
+        f(*m_typeLatencyHist[i]);
+        f(*m_hitTypeLatencyHist[i]);
+        f(*m_missTypeLatencyHist[i]);
         for (int j = 0; j < MachineType_NUM; j++) {
-            m_hitTypeMachLatencyHist[i][j]->reset();
-            m_missTypeMachLatencyHist[i][j]->reset();
+            f(*m_hitTypeMachLatencyHist[i][j]);
+            f(*m_missTypeMachLatencyHist[i][j]);
         }
     }
 
     for (int i = 0; i < MachineType_NUM; i++) {
-        m_missMachLatencyHist[i]->reset();
-        m_hitMachLatencyHist[i]->reset();
+        f(*m_missMachLatencyHist[i]);
+        f(*m_hitMachLatencyHist[i]);
 
-        m_IssueToInitialDelayHist[i]->reset();
-        m_InitialToForwardDelayHist[i]->reset();
-        m_ForwardToFirstResponseDelayHist[i]->reset();
-        m_FirstResponseToCompletionDelayHist[i]->reset();
+        f(*m_IssueToInitialDelayHist[i]);
+        f(*m_InitialToForwardDelayHist[i]);
+        f(*m_ForwardToFirstResponseDelayHist[i]);
+        f(*m_FirstResponseToCompletionDelayHist[i]);
+    }
+}
 
+void Sequencer::resetStats()
+{
+    m_outstandReqHist.discard();
+    forEachLatencyHist([](DeferredHistogram &hist) {
+        hist.discard();
+        hist.reset();
+    });
+
+    for (int i = 0; i < MachineType_NUM; i++) {
         m_IncompleteTimes[i] = 0;
     }
 }
 
+void
+Sequencer::collateStats()
+{
+    m_outstandReqHist.flush();
+    forEachLatencyHist([](DeferredHistogram &hist) { hist.flush(); });
+}
+
+void
+Sequencer::sampleHist(DeferredHistogram &hist, uint64_t value)
+{
+    if (m_lightweightStats)
+        hist.defer(value);
+    else
+        hist.sample(value);
+}
+
 // Insert the request on the correct request table.  Return true if
 // the entry was already present.
 RequestStatus
@@ -185,11 +233,6 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType request_type)
         return RequestStatus_Aliased;
     }
 
-    // Create a default entry, mapping the address to NULL, the cast is
-    // there to make gcc 4.4 happy
-    RequestTable::value_type default_entry(line_addr,
-                                           (SequencerRequest*) NULL);
-
     if ((request_type == RubyRequestType_ST) ||
         (request_type == RubyRequestType_RMW_Read) ||
         (request_type == RubyRequestType_RMW_Write) ||
@@ -206,17 +249,15 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType request_type)
             return RequestStatus_Aliased;
         }
 
-        pair<RequestTable::iterator, bool> r =
-            m_writeRequestTable.insert(default_entry);
-        if (r.second) {
-            RequestTable::iterator i = r.first;
-            i->second = new SequencerRequest(pkt, request_type, curCycle());
-            m_outstanding_count++;
-        } else {
+        if (m_writeRequestTable.count(line_addr) > 0) {
           // There is an outstanding write request for the cache line
           m_store_waiting_on_store++;
           return RequestStatus_Aliased;
         }
+
+        m_writeRequestTable.insert(line_addr,
+            new SequencerRequest(pkt, request_type, curCycle()));
+        m_outstanding_count++;
     } else {
         // Check if there is any outstanding write request for the same
         // cache line.
@@ -225,21 +266,18 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType request_type)
             return RequestStatus_Aliased;
         }
 
-        pair<RequestTable::iterator, bool> r =
-            m_readRequestTable.insert(default_entry);
-
-        if (r.second) {
-            RequestTable::iterator i = r.first;
-            i->second = new SequencerRequest(pkt, request_type, curCycle());
-            m_outstanding_count++;
-        } else {
+        if (m_readRequestTable.count(line_addr) > 0) {
             // There is an outstanding read request for the cache line
             m_load_waiting_on_load++;
             return RequestStatus_Aliased;
         }
+
+        m_readRequestTable.insert(line_addr,
+            new SequencerRequest(pkt, request_type, curCycle()));
+        m_outstanding_count++;
     }
 
-    m_outstandReqHist.sample(m_outstanding_count);
+    sampleHist(m_outstandReqHist, m_outstanding_count);
     assert(m_outstanding_count ==
         (m_writeRequestTable.size() + m_readRequestTable.size()));
 
@@ -318,41 +356,45 @@ Sequencer::recordMissLatency(const Cycles cycles, const RubyRequestType type,
                              Cycles forwardRequestTime,
                              Cycles firstResponseTime, Cycles completionTime)
 {
-    m_latencyHist.sample(cycles);
-    m_typeLatencyHist[type]->sample(cycles);
+    sampleHist(m_latencyHist, cycles);
+    sampleHist(*m_typeLatencyHist[type], cycles);
 
     if (isExternalHit) {
-        m_missLatencyHist.sample(cycles);
-        m_missTypeLatencyHist[type]->sample(cycles);
+        sampleHist(m_missLatencyHist, cycles);
+        sampleHist(*m_missTypeLatencyHist[type], cycles);
 
         if (respondingMach != MachineType_NUM) {
-            m_missMachLatencyHist[respondingMach]->sample(cycles);
-            m_missTypeMachLatencyHist[type][respondingMach]->sample(cycles);
+            sampleHist(*m_missMachLatencyHist[respondingMach], cycles);
+            sampleHist(*m_missTypeMachLatencyHist[type][respondingMach],
+                       cycles);
 
             if ((issuedTime <= initialRequestTime) &&
                 (initialRequestTime <= forwardRequestTime) &&
                 (forwardRequestTime <= firstResponseTime) &&
                 (firstResponseTime <= completionTime)) {
 
-                m_IssueToInitialDelayHist[respondingMach]->sample(
+                sampleHist(*m_IssueToInitialDelayHist[respondingMach],
                     initialRequestTime - issuedTime);
-                m_InitialToForwardDelayHist[respondingMach]->sample(
+                sampleHist(*m_InitialToForwardDelayHist[respondingMach],
                     forwardRequestTime - initialRequestTime);
-                m_ForwardToFirstResponseDelayHist[respondingMach]->sample(
+                sampleHist(
+                    *m_ForwardToFirstResponseDelayHist[respondingMach],
                     firstResponseTime - forwardRequestTime);
-                m_FirstResponseToCompletionDelayHist[respondingMach]->sample(
+                sampleHist(
+                    *m_FirstResponseToCompletionDelayHist[respondingMach],
                     completionTime - firstResponseTime);
             } else {
                 m_IncompleteTimes[respondingMach]++;
             }
         }
     } else {
-        m_hitLatencyHist.sample(cycles);
-        m_hitTypeLatencyHist[type]->sample(cycles);
+        sampleHist(m_hitLatencyHist, cycles);
+        sampleHist(*m_hitTypeLatencyHist[type], cycles);
 
         if (respondingMach != MachineType_NUM) {
-            m_hitMachLatencyHist[respondingMach]->sample(cycles);
-            m_hitTypeMachLatencyHist[type][respondingMach]->sample(cycles);
+            sampleHist(*m_hitMachLatencyHist[respondingMach], cycles);
+            sampleHist(*m_hitTypeMachLatencyHist[type][respondingMach],
+                       cycles);
         }
     }
 }
@@ -367,11 +409,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     assert(address == makeLineAddress(address));
     assert(m_writeRequestTable.count(makeLineAddress(address)));
 
-    RequestTable::iterator i = m_writeRequestTable.find(address);
-    assert(i != m_writeRequestTable.end());
-    SequencerRequest* request = i->second;
-
-    m_writeRequestTable.erase(i);
+    SequencerRequest* request = m_writeRequestTable.erase(address);
     markRemoved();
 
     assert((request->m_type == RubyRequestType_ST) ||
@@ -422,11 +460,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     assert(address == makeLineAddress(address));
     assert(m_readRequestTable.count(makeLineAddress(address)));
 
-    RequestTable::iterator i = m_readRequestTable.find(address);
-    assert(i != m_readRequestTable.end());
-    SequencerRequest* request = i->second;
-
-    m_readRequestTable.erase(i);
+    SequencerRequest* request = m_readRequestTable.erase(address);
     markRemoved();
 
     assert((request->m_type == RubyRequestType_LD) ||
@@ -642,12 +676,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     // check if the packet has data as for example prefetch and flush
     // requests do not
     std::shared_ptr<RubyRequest> msg =
-        std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                      pkt->isFlush() ?
-                                      nullptr : pkt->getPtr<uint8_t>(),
-                                      pkt->getSize(), pc, secondary_type,
-                                      RubyAccessMode_Supervisor, pkt,
-                                      PrefetchBit_No, proc_id, core_id);
+        makeMessage<RubyRequest>(clockEdge(), pkt->getAddr(),
+                                 pkt->isFlush() ?
+                                 nullptr : pkt->getPtr<uint8_t>(),
+                                 pkt->getSize(), pc, secondary_type,
+                                 RubyAccessMode_Supervisor, pkt,
+                                 PrefetchBit_No, proc_id, core_id);
 
     DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %#x %s\n",
             curTick(), m_version, "Seq", "Begin", "", "",
@@ -673,16 +707,13 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), cyclesToTicks(latency));
 }
 
-template <class KEY, class VALUE>
 std::ostream &
-operator<<(ostream &out, const std::unordered_map<KEY, VALUE> &map)
+operator<<(ostream &out, const SequencerRequestTable &table)
 {
-    auto i = map.begin();
-    auto end = map.end();
-
     out << "[";
-    for (; i != end; ++i)
-        out << " " << i->first << "=" << i->second;
+    table.forEach([&](Addr line, SequencerRequest* request) {
+        out << " " << line << "=" << request;
+    });
     out << " ]";
 
     return out;
@@ -753,45 +784,45 @@ Sequencer::regStats()
     m_missLatencyHist.init(10);
 
     for (int i = 0; i < RubyRequestType_NUM; i++) {
-        m_typeLatencyHist.push_back(new Stats::Histogram());
+        m_typeLatencyHist.push_back(new DeferredHistogram());
         m_typeLatencyHist[i]->init(10);
 
-        m_hitTypeLatencyHist.push_back(new Stats::Histogram());
+        m_hitTypeLatencyHist.push_back(new DeferredHistogram());
         m_hitTypeLatencyHist[i]->init(10);
 
-        m_missTypeLatencyHist.push_back(new Stats::Histogram());
+        m_missTypeLatencyHist.push_back(new DeferredHistogram());
         m_missTypeLatencyHist[i]->init(10);
     }
 
     for (int i = 0; i < MachineType_NUM; i++) {
-        m_hitMachLatencyHist.push_back(new Stats::Histogram());
+        m_hitMachLatencyHist.push_back(new DeferredHistogram());
         m_hitMachLatencyHist[i]->init(10);
 
-        m_missMachLatencyHist.push_back(new Stats::Histogram());
+        m_missMachLatencyHist.push_back(new DeferredHistogram());
         m_missMachLatencyHist[i]->init(10);
 
-        m_IssueToInitialDelayHist.push_back(new Stats::Histogram());
+        m_IssueToInitialDelayHist.push_back(new DeferredHistogram());
         m_IssueToInitialDelayHist[i]->init(10);
 
-        m_InitialToForwardDelayHist.push_back(new Stats::Histogram());
+        m_InitialToForwardDelayHist.push_back(new DeferredHistogram());
         m_InitialToForwardDelayHist[i]->init(10);
 
-        m_ForwardToFirstResponseDelayHist.push_back(new Stats::Histogram());
+        m_ForwardToFirstResponseDelayHist.push_back(new DeferredHistogram());
         m_ForwardToFirstResponseDelayHist[i]->init(10);
 
-        m_FirstResponseToCompletionDelayHist.push_back(new Stats::Histogram());
+        m_FirstResponseToCompletionDelayHist.push_back(new DeferredHistogram());
         m_FirstResponseToCompletionDelayHist[i]->init(10);
     }
 
     for (int i = 0; i < RubyRequestType_NUM; i++) {
-        m_hitTypeMachLatencyHist.push_back(std::vector<Stats::Histogram *>());
-        m_missTypeMachLatencyHist.push_back(std::vector<Stats::Histogram *>());
+        m_hitTypeMachLatencyHist.push_back(std::vector<DeferredHistogram *>());
+        m_missTypeMachLatencyHist.push_back(std::vector<DeferredHistogram *>());
 
         for (int j = 0; j < MachineType_NUM; j++) {
-            m_hitTypeMachLatencyHist[i].push_back(new Stats::Histogram());
+            m_hitTypeMachLatencyHist[i].push_back(new DeferredHistogram());
             m_hitTypeMachLatencyHist[i][j]->init(10);
 
-            m_missTypeMachLatencyHist[i].push_back(new Stats::Histogram());
+            m_missTypeMachLatencyHist[i].push_back(new DeferredHistogram());
             m_missTypeMachLatencyHist[i][j]->init(10);
         }
     }
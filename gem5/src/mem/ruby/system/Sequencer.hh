@@ -30,8 +30,10 @@
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/intmath.hh"
+#include "base/statistics.hh"
 #include "mem/protocol/MachineType.hh"
 #include "mem/protocol/RubyRequestType.hh"
 #include "mem/protocol/SequencerRequestType.hh"
@@ -54,6 +56,155 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+/**
+ * Outstanding requests of a sequencer, indexed by line address. The
+ * number of requests is bounded by max_outstanding_requests, so the
+ * table is a fixed array with open addressing (linear probing) kept at
+ * most half full. Deletion shifts the following entries of the probe
+ * run back, so no tombstones are needed and lookups stay short.
+ */
+class SequencerRequestTable
+{
+  public:
+    SequencerRequestTable() : m_bits(0), m_size(0) {}
+
+    void
+    init(int max_entries)
+    {
+        int capacity = 1 << ceilLog2(2 * max_entries);
+        m_bits = floorLog2(capacity);
+        m_slots.assign(capacity, Slot());
+        m_size = 0;
+    }
+
+    /** The request for a line, or nullptr if there is none. */
+    SequencerRequest *
+    find(Addr line) const
+    {
+        for (size_t i = index(line); m_slots[i].request; i = next(i)) {
+            if (m_slots[i].line == line)
+                return m_slots[i].request;
+        }
+        return nullptr;
+    }
+
+    bool count(Addr line) const { return find(line) != nullptr; }
+
+    /** Insert a request, returns false if the line is already present. */
+    bool
+    insert(Addr line, SequencerRequest *request)
+    {
+        assert(request);
+        size_t i = index(line);
+        for (; m_slots[i].request; i = next(i)) {
+            if (m_slots[i].line == line)
+                return false;
+        }
+        panic_if(2 * (m_size + 1) > m_slots.size(),
+                 "Sequencer request table overflow\n");
+        m_slots[i].line = line;
+        m_slots[i].request = request;
+        m_size++;
+        return true;
+    }
+
+    /** Remove the request for a line and return it. */
+    SequencerRequest *
+    erase(Addr line)
+    {
+        size_t i = index(line);
+        while (m_slots[i].line != line || !m_slots[i].request) {
+            assert(m_slots[i].request);
+            i = next(i);
+        }
+        SequencerRequest *request = m_slots[i].request;
+        m_size--;
+
+        // Move back any later entry of the run that may no longer be
+        // reachable from its home slot once this one is empty
+        size_t hole = i;
+        for (size_t j = next(i); m_slots[j].request; j = next(j)) {
+            size_t home = index(m_slots[j].line);
+            if (((j - home) & mask()) >= ((j - hole) & mask())) {
+                m_slots[hole] = m_slots[j];
+                hole = j;
+            }
+        }
+        m_slots[hole] = Slot();
+        return request;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /** Call f(line, request) on every outstanding request. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &slot : m_slots) {
+            if (slot.request)
+                f(slot.line, slot.request);
+        }
+    }
+
+  private:
+    struct Slot
+    {
+        Slot() : line(0), request(nullptr) {}
+        Addr line;
+        SequencerRequest *request;
+    };
+
+    size_t mask() const { return m_slots.size() - 1; }
+    size_t next(size_t i) const { return (i + 1) & mask(); }
+
+    size_t
+    index(Addr line) const
+    {
+        // Fibonacci hashing spreads the block-aligned addresses
+        return (line * 0x9e3779b97f4a7c15ULL) >> (64 - m_bits);
+    }
+
+    std::vector<Slot> m_slots;
+    int m_bits;
+    size_t m_size;
+};
+
+std::ostream& operator<<(std::ostream& out, const SequencerRequestTable& obj);
+
+/**
+ * A latency histogram that can defer its samples. In lightweight mode
+ * the sequencer only counts how often each value occurs; the histogram
+ * then sees every distinct value once, with its count, when the stats
+ * are collated. Values beyond the counted range are sampled right away.
+ */
+class DeferredHistogram : public Stats::Histogram
+{
+  public:
+    void
+    defer(uint64_t value)
+    {
+        if (value >= MaxDeferred) {
+            sample(value);
+            return;
+        }
+        if (pending.empty())
+            pending.resize(MaxDeferred, 0);
+        pending[value]++;
+    }
+
+    /** Move the deferred samples into the histogram. */
+    void flush();
+
+    /** Drop the deferred samples, e.g. on a stats reset. */
+    void discard() { pending.clear(); }
+
+  private:
+    static const uint64_t MaxDeferred = 1024;
+    std::vector<uint64_t> pending;
+};
+
 class Sequencer : public RubyPort
 {
   public:
@@ -165,6 +316,13 @@ class Sequencer : public RubyPort
                            Cycles forwardRequestTime, Cycles firstResponseTime,
                            Cycles completionTime);
 
+    /** Sample a histogram, deferred in lightweight mode. */
+    void sampleHist(DeferredHistogram &hist, uint64_t value);
+
+    /** Call f on every latency histogram. */
+    template <class F>
+    void forEachLatencyHist(F f);
+
     RequestStatus insertRequest(PacketPtr pkt, RubyRequestType request_type);
     bool handleLlsc(Addr address, SequencerRequest* request);
 
@@ -186,7 +344,7 @@ class Sequencer : public RubyPort
     Cycles m_data_cache_hit_latency;
     Cycles m_inst_cache_hit_latency;
 
-    typedef std::unordered_map<Addr, SequencerRequest*> RequestTable;
+    typedef SequencerRequestTable RequestTable;
     RequestTable m_writeRequestTable;
     RequestTable m_readRequestTable;
     // Global outstanding request count, across all request tables
@@ -203,38 +361,41 @@ class Sequencer : public RubyPort
 
     bool m_runningGarnetStandalone;
 
+    //! Count latencies per value and fill the histograms at dump time
+    bool m_lightweightStats;
+
     //! Histogram for number of outstanding requests per cycle.
-    Stats::Histogram m_outstandReqHist;
+    DeferredHistogram m_outstandReqHist;
 
     //! Histogram for holding latency profile of all requests.
-    Stats::Histogram m_latencyHist;
-    std::vector<Stats::Histogram *> m_typeLatencyHist;
+    DeferredHistogram m_latencyHist;
+    std::vector<DeferredHistogram *> m_typeLatencyHist;
 
     //! Histogram for holding latency profile of all requests that
     //! hit in the controller connected to this sequencer.
-    Stats::Histogram m_hitLatencyHist;
-    std::vector<Stats::Histogram *> m_hitTypeLatencyHist;
+    DeferredHistogram m_hitLatencyHist;
+    std::vector<DeferredHistogram *> m_hitTypeLatencyHist;
 
     //! Histograms for profiling the latencies for requests that
     //! did not required external messages.
-    std::vector<Stats::Histogram *> m_hitMachLatencyHist;
-    std::vector< std::vector<Stats::Histogram *> > m_hitTypeMachLatencyHist;
+    std::vector<DeferredHistogram *> m_hitMachLatencyHist;
+    std::vector< std::vector<DeferredHistogram *> > m_hitTypeMachLatencyHist;
 
     //! Histogram for holding latency profile of all requests that
     //! miss in the controller connected to this sequencer.
-    Stats::Histogram m_missLatencyHist;
-    std::vector<Stats::Histogram *> m_missTypeLatencyHist;
+    DeferredHistogram m_missLatencyHist;
+    std::vector<DeferredHistogram *> m_missTypeLatencyHist;
 
     //! Histograms for profiling the latencies for requests that
     //! required external messages.
-    std::vector<Stats::Histogram *> m_missMachLatencyHist;
-    std::vector< std::vector<Stats::Histogram *> > m_missTypeMachLatencyHist;
+    std::vector<DeferredHistogram *> m_missMachLatencyHist;
+    std::vector< std::vector<DeferredHistogram *> > m_missTypeMachLatencyHist;
 
     //! Histograms for recording the breakdown of miss latency
-    std::vector<Stats::Histogram *> m_IssueToInitialDelayHist;
-    std::vector<Stats::Histogram *> m_InitialToForwardDelayHist;
-    std::vector<Stats::Histogram *> m_ForwardToFirstResponseDelayHist;
-    std::vector<Stats::Histogram *> m_FirstResponseToCompletionDelayHist;
+    std::vector<DeferredHistogram *> m_IssueToInitialDelayHist;
+    std::vector<DeferredHistogram *> m_InitialToForwardDelayHist;
+    std::vector<DeferredHistogram *> m_ForwardToFirstResponseDelayHist;
+    std::vector<DeferredHistogram *> m_FirstResponseToCompletionDelayHist;
     std::vector<Stats::Counter> m_IncompleteTimes;
 
     EventFunctionWrapper deadlockCheckEvent;
@@ -74,6 +74,10 @@ class RubySequencer(RubyPort):
    deadlock_threshold = Param.Cycles(500000,
        "max outstanding cycles for a request before deadlock/livelock declared")
    garnet_standalone = Param.Bool(False, "")
+   # only count latencies on the request path and build the histograms
+   # when the stats are collated
+   lightweight_latency_stats = Param.Bool(False,
+       "defer latency histogram sampling to stats collation")
    # id used by protocols that support multiple sequencers per controller
    # 99 is the dummy default value
    coreid = Param.Int(99, "CorePair core id")
@@ -39,6 +39,7 @@ python_class_map = {
                     "uint32_t" : "UInt32",
                     "std::string": "String",
                     "bool": "Bool",
+                    "BloomSnoopFilter": "RubyBloomSnoopFilter",
                     "CacheMemory": "RubyCache",
                     "WireBuffer": "RubyWireBuffer",
                     "Sequencer": "RubySequencer",
@@ -92,6 +93,8 @@ class StateMachine(Symbol):
         self.objects = []
         self.TBEType   = None
         self.EntryType = None
+        self.DirEntryTypes = []
+        self.hasSecondaryEntryType = False
         self.debug_flags = set()
         self.debug_flags.add('RubyGenerated')
         self.debug_flags.add('RubySlicc')
@@ -157,13 +160,17 @@ class StateMachine(Symbol):
 
         elif "interface" in type and "AbstractCacheEntry" == type["interface"]:
             if "main" in type and "false" == type["main"].lower():
-                pass # this isn't the EntryType
+                # this isn't the EntryType
+                self.hasSecondaryEntryType = True
             else:
                 if self.EntryType != None:
                     self.error("Multiple AbstractCacheEntry types in a " \
                                "single machine.");
                 self.EntryType = type
 
+        elif "interface" in type and "AbstractEntry" == type["interface"]:
+            self.DirEntryTypes.append(type)
+
     # Needs to be called before accessing the table
     def buildTable(self):
         assert self.table is None
@@ -309,6 +316,9 @@ class $c_ident : public AbstractController
     void collateStats();
 
     void recordCacheTrace(int cntrl, CacheRecorder* tr);
+    const char *cacheSnapshotProblem() const;
+    void saveCacheSnapshot(CacheSnapshot &snap);
+    void loadCacheSnapshot(CacheSnapshot &snap);
     Sequencer* getCPUSequencer() const;
     GPUCoalescer* getGPUCoalescer() const;
 
@@ -933,6 +943,86 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
         code.dedent()
         code('''
 }
+''')
+
+        #
+        # Save and restore the exact contents of all associated caches and
+        # directories. The entries are recreated with the machine's entry
+        # types, which is ambiguous when it declares several of them, and
+        # all their fields must be storable. Protocols that do not meet
+        # this still build, but refuse to run with cache snapshots.
+        #
+        caches = [ param for param in self.config_parameters
+                   if param.type_ast.type.ident == "CacheMemory" ]
+        dirs = [ param for param in self.config_parameters
+                 if param.type_ast.type.ident == "DirectoryMemory" ]
+        snapshot_problem = None
+        if caches and (self.EntryType == None or self.hasSecondaryEntryType):
+            snapshot_problem = "several cache entry types"
+        elif dirs and len(self.DirEntryTypes) != 1:
+            snapshot_problem = "several directory entry types"
+        else:
+            entry_types = []
+            if caches:
+                entry_types.append(self.EntryType)
+            if dirs:
+                entry_types.append(self.DirEntryTypes[0])
+            for entry_type in entry_types:
+                if entry_type.snapshotUnstorable:
+                    snapshot_problem = "cannot store %s of %s" % \
+                        (", ".join(entry_type.snapshotUnstorable),
+                         entry_type.c_ident)
+                    break
+        snapshot_ok = snapshot_problem == None
+
+        code('''
+const char *
+$c_ident::cacheSnapshotProblem() const
+{
+''')
+        code.indent()
+        if snapshot_ok:
+            code('return NULL;')
+        else:
+            code('return "$snapshot_problem";')
+        code.dedent()
+        code('''
+}
+
+void
+$c_ident::saveCacheSnapshot(CacheSnapshot &snap)
+{
+''')
+        code.indent()
+        if snapshot_ok:
+            for param in caches + dirs:
+                code('m_${{param.ident}}_ptr->saveSnapshot(snap);')
+        else:
+            code('fatal("%s: cannot snapshot the caches, %s", name(),')
+            code('      cacheSnapshotProblem());')
+        code.dedent()
+        code('''
+}
+
+void
+$c_ident::loadCacheSnapshot(CacheSnapshot &snap)
+{
+''')
+        code.indent()
+        if snapshot_ok:
+            for param in caches:
+                code('m_${{param.ident}}_ptr->loadSnapshot(snap,')
+                code('    []{ return new ${{self.EntryType.c_ident}}; });')
+            for param in dirs:
+                entry_type = self.DirEntryTypes[0]
+                code('m_${{param.ident}}_ptr->loadSnapshot(snap,')
+                code('    []{ return new ${{entry_type.c_ident}}; });')
+        else:
+            code('fatal("%s: cannot snapshot the caches, %s", name(),')
+            code('      cacheSnapshotProblem());')
+        code.dedent()
+        code('''
+}
 
 // Actions
 ''')
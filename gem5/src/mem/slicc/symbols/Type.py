@@ -122,6 +122,29 @@ class Type(Symbol):
     def isInterface(self):
         return "interface" in self
 
+    # Field types that CacheSnapshot knows how to store
+    snapshot_types = ("bool", "int", "uint32_t", "uint64_t", "Addr",
+                      "Cycles", "Tick", "MachineID", "DataBlock", "NetDest",
+                      "Set")
+
+    @property
+    def snapshotUnstorable(self):
+        """The fields of an entry that a cache snapshot cannot store,
+        e.g. the WriteMask of the GPU protocols."""
+        return [ "%s (%s)" % (dm.ident, dm.type.c_ident)
+                 for dm in self.data_members.values()
+                 if "abstract" not in dm and not dm.type.isEnumeration and
+                    dm.type.c_ident not in self.snapshot_types ]
+
+    @property
+    def isSnapshotable(self):
+        """Cache and directory entries get methods to save and load them
+        from a cache snapshot if all of their fields can be stored."""
+        if "interface" not in self or \
+           self["interface"] not in ("AbstractCacheEntry", "AbstractEntry"):
+            return False
+        return not self.snapshotUnstorable
+
     # Return false on error
     def addDataMember(self, ident, type, pairs, init_code):
         if ident in self.data_members:
@@ -290,7 +313,7 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return makeMessage<${{self.c_ident}}>(*this);
 }
 ''')
         else:
@@ -344,6 +367,9 @@ set${{dm.ident}}(const ${{dm.type.c_ident}}& local_${{dm.ident}})
 ''')
 
         code('void print(std::ostream& out) const;')
+        if self.isSnapshotable:
+            code('void saveSnapshot(CacheSnapshot &snap) const;')
+            code('void loadSnapshot(CacheSnapshot &snap);')
         code.dedent()
         code('  //private:')
         code.indent()
@@ -406,7 +432,11 @@ operator<<(std::ostream& out, const ${{self.c_ident}}& obj)
 
 #include "mem/protocol/${{self.c_ident}}.hh"
 #include "mem/ruby/system/RubySystem.hh"
+''')
+        if self.isSnapshotable:
+            code('#include "mem/ruby/system/CacheSnapshot.hh"')
 
+        code('''
 using namespace std;
 ''')
 
@@ -434,6 +464,31 @@ out << "${{dm.ident}} = " << printAddress(m_${{dm.ident}}) << " ";''')
     out << "]";
 }''')
 
+        if self.isSnapshotable:
+            code('''
+
+void
+${{self.c_ident}}::saveSnapshot(CacheSnapshot &snap) const
+{
+    snap.put(m_Permission);''')
+            code.indent()
+            for dm in self.data_members.values():
+                if "abstract" not in dm:
+                    code('snap.put(m_${{dm.ident}});')
+            code.dedent()
+            code('''}
+
+void
+${{self.c_ident}}::loadSnapshot(CacheSnapshot &snap)
+{
+    snap.get(m_Permission);''')
+            code.indent()
+            for dm in self.data_members.values():
+                if "abstract" not in dm:
+                    code('snap.get(m_${{dm.ident}});')
+            code.dedent()
+            code('}')
+
         # print the code for the methods in the type
         for item in self.methods:
             code(self.methods[item].generateCode())
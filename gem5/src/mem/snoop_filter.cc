@@ -47,6 +47,7 @@
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 void
@@ -60,8 +61,130 @@ SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
     }
 }
 
+Addr
+SnoopFilter::regionAddr(const Packet* cpkt) const
+{
+    Addr region_addr = cpkt->getBlockAddr(regionSize);
+    if (cpkt->isSecure()) {
+        region_addr |= LineSecure;
+    }
+    return region_addr;
+}
+
+unsigned
+SnoopFilter::regionLine(const Packet* cpkt) const
+{
+    return (cpkt->getAddr() & (regionSize - 1)) / linesize;
+}
+
+unsigned
+SnoopFilter::regionPort(const SlavePort& port) const
+{
+    assert(port.isSnooping());
+    return localSlavePortIds[port.getId()];
+}
+
+void
+SnoopFilter::eraseIfNullRegion(RegionFilterCache::iterator& region_it)
+{
+    if (region_it->second.empty()) {
+        cachedRegions.erase(region_it);
+        region_it = cachedRegions.end();
+        DPRINTF(SnoopFilter, "%s:   Removed SF region.\n", __func__);
+    }
+}
+
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
+{
+    auto res = tracksRegions() ? lookupRequestRegion(cpkt, slave_port) :
+        lookupRequestLine(cpkt, slave_port);
+
+    // Evictions only use the result to tell if the block is still
+    // cached above, they are never snooped
+    if (!cpkt->isEviction()) {
+        snoopTargets += res.first.size();
+        snoopCandidates += slavePorts.size() -
+            (slave_port.isSnooping() ? 1 : 0);
+    }
+    return res;
+}
+
+std::pair<SnoopFilter::SnoopList, Cycles>
+SnoopFilter::lookupRequestRegion(const Packet* cpkt,
+                                 const SlavePort& slave_port)
+{
+    DPRINTF(SnoopFilter, "%s: src %s packet %s\n", __func__,
+            slave_port.name(), cpkt->print());
+
+    bool allocate = !cpkt->req->isUncacheable() && slave_port.isSnooping() &&
+        cpkt->fromCache();
+    Addr region_addr = regionAddr(cpkt);
+    SnoopMask req_port = portToMask(slave_port);
+    regionLookupResult = cachedRegions.find(region_addr);
+    bool is_hit = (regionLookupResult != cachedRegions.end());
+    retryRegionPort = -1;
+
+    if (!is_hit && !allocate)
+        return snoopDown(lookupLatency);
+
+    if (!is_hit) {
+        regionLookupResult = cachedRegions.emplace(region_addr,
+            SnoopRegion(slavePorts.size())).first;
+    }
+    SnoopRegion& region = regionLookupResult->second;
+    unsigned line = regionLine(cpkt);
+    // Private regions are settled here without visiting any line
+    SnoopMask interested = region.lineInterest(line, ~req_port);
+
+    totRequests++;
+    if (is_hit) {
+        if (isPow2(region.interest()))
+            hitSingleRequests++;
+        else
+            hitMultiRequests++;
+    }
+
+    DPRINTF(SnoopFilter, "%s:   SF region value %x.%x, line %x\n",
+            __func__, region.requestedPorts(), region.holderPorts(),
+            interested);
+
+    if (!allocate)
+        return snoopSelected(maskToPortList(interested), lookupLatency);
+
+    // Keep the requester's lines in case finishRequest has to revert
+    unsigned port = regionPort(slave_port);
+    retryRegionPort = port;
+    retryRegionLines = region.portLines(port);
+
+    if (cpkt->needsResponse()) {
+        if (!cpkt->cacheResponding()) {
+            panic_if(region.requests(port, line), "double request :( " \
+                     "SF region value %x.%x\n", region.requestedPorts(),
+                     region.holderPorts());
+            region.setRequested(port, line, true);
+        } else {
+            // A cache closer to the requester responds, so the
+            // cluster already has a copy
+            panic_if(!region.holds(port, line), "Need to hold the value!");
+        }
+    } else {
+        assert(cpkt->isEviction());
+        panic_if(!region.holds(port, line), "requester %x is not a " \
+                 "holder :( SF region value %x.%x\n", req_port,
+                 region.requestedPorts(), region.holderPorts());
+        if (!cpkt->isBlockCached())
+            region.setHolder(port, line, false);
+    }
+
+    DPRINTF(SnoopFilter, "%s:   new SF region value %x.%x\n", __func__,
+            region.requestedPorts(), region.holderPorts());
+
+    return snoopSelected(maskToPortList(interested), lookupLatency);
+}
+
+std::pair<SnoopFilter::SnoopList, Cycles>
+SnoopFilter::lookupRequestLine(const Packet* cpkt, const SlavePort& slave_port)
 {
     DPRINTF(SnoopFilter, "%s: src %s packet %s\n", __func__,
             slave_port.name(), cpkt->print());
@@ -152,6 +275,26 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
+    if (tracksRegions()) {
+        if (regionLookupResult == cachedRegions.end())
+            return;
+
+        Addr region_addr = (addr & ~(Addr(regionSize - 1)));
+        if (is_secure) {
+            region_addr |= LineSecure;
+        }
+        assert(regionLookupResult->first == region_addr);
+        if (will_retry && retryRegionPort >= 0) {
+            regionLookupResult->second.setPortLines(retryRegionPort,
+                                                    retryRegionLines);
+            DPRINTF(SnoopFilter, "%s:   restored SF lines of port %d\n",
+                    __func__, retryRegionPort);
+        }
+
+        eraseIfNullRegion(regionLookupResult);
+        return;
+    }
+
     if (reqLookupResult != cachedLocations.end()) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
@@ -176,6 +319,53 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupSnoop(const Packet* cpkt)
+{
+    auto res = tracksRegions() ? lookupSnoopRegion(cpkt) :
+        lookupSnoopLine(cpkt);
+
+    snoopTargets += res.first.size();
+    snoopCandidates += slavePorts.size();
+    return res;
+}
+
+std::pair<SnoopFilter::SnoopList, Cycles>
+SnoopFilter::lookupSnoopRegion(const Packet* cpkt)
+{
+    DPRINTF(SnoopFilter, "%s: packet %s\n", __func__, cpkt->print());
+
+    assert(cpkt->isRequest());
+
+    auto sf_it = cachedRegions.find(regionAddr(cpkt));
+    if (sf_it == cachedRegions.end())
+        return snoopDown(lookupLatency);
+
+    SnoopRegion& region = sf_it->second;
+    unsigned line = regionLine(cpkt);
+    SnoopMask requested = region.lineRequested(line);
+    SnoopMask interested = requested | region.lineHolder(line);
+
+    totSnoops++;
+    if (isPow2(interested))
+        hitSingleSnoops++;
+    else
+        hitMultiSnoops++;
+
+    // As in the line mode, drop the holders of an invalidated line
+    // unless a request for it is still going on
+    if (cpkt->isInvalidate() && !requested)
+        region.clearHolders(line);
+
+    DPRINTF(SnoopFilter, "%s:   new SF region value %x.%x interest: %x\n",
+            __func__, region.requestedPorts(), region.holderPorts(),
+            interested);
+
+    eraseIfNullRegion(sf_it);
+
+    return snoopSelected(maskToPortList(interested), lookupLatency);
+}
+
+std::pair<SnoopFilter::SnoopList, Cycles>
+SnoopFilter::lookupSnoopLine(const Packet* cpkt)
 {
     DPRINTF(SnoopFilter, "%s: packet %s\n", __func__, cpkt->print());
 
@@ -254,6 +444,31 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
         return;
     }
 
+    if (tracksRegions()) {
+        auto region_it = cachedRegions.find(regionAddr(cpkt));
+        panic_if(region_it == cachedRegions.end(), "No SF region for "\
+                 "snoop response to %#x\n", cpkt->getAddr());
+        SnoopRegion& region = region_it->second;
+        unsigned line = regionLine(cpkt);
+        unsigned req = regionPort(req_port);
+
+        panic_if(!region.holds(regionPort(rsp_port), line), "SF region "\
+                 "value %x.%x does not have the line\n",
+                 region.requestedPorts(), region.holderPorts());
+        panic_if(!region.requests(req, line), "SF region value %x.%x "\
+                 "missing the original request\n",
+                 region.requestedPorts(), region.holderPorts());
+
+        // As below, without sharers no other copies of the line remain
+        if (!cpkt->hasSharers())
+            region.clearHolders(line);
+        region.setHolder(req, line, true);
+        region.setRequested(req, line, false);
+        DPRINTF(SnoopFilter, "%s:   new SF region value %x.%x\n",
+                __func__, region.requestedPorts(), region.holderPorts());
+        return;
+    }
+
     Addr line_addr = cpkt->getBlockAddr(linesize);
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
@@ -302,6 +517,18 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     assert(cpkt->isResponse());
     assert(cpkt->cacheResponding());
 
+    if (tracksRegions()) {
+        auto region_it = cachedRegions.find(regionAddr(cpkt));
+        if (region_it == cachedRegions.end())
+            return;
+
+        // No other copies of the line remain, see below
+        if (!cpkt->hasSharers())
+            region_it->second.clearHolders(regionLine(cpkt));
+        eraseIfNullRegion(region_it);
+        return;
+    }
+
     Addr line_addr = cpkt->getBlockAddr(linesize);
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
@@ -343,6 +570,33 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
     if (cpkt->req->isUncacheable() || !slave_port.isSnooping())
         return;
 
+    if (tracksRegions()) {
+        auto region_it = cachedRegions.find(regionAddr(cpkt));
+        if (region_it == cachedRegions.end())
+            return;
+        SnoopRegion& region = region_it->second;
+        unsigned line = regionLine(cpkt);
+        unsigned port = regionPort(slave_port);
+
+        panic_if(!region.requests(port, line), "SF region value %x.%x "\
+                 "missing request bit\n", region.requestedPorts(),
+                 region.holderPorts());
+        region.setRequested(port, line, false);
+
+        // As below, cache maintenance only drops the line if it
+        // invalidates, any other response leaves a copy above
+        if (cpkt->req->isCacheMaintenance()) {
+            if (cpkt->isInvalidate())
+                region.setHolder(port, line, false);
+            eraseIfNullRegion(region_it);
+        } else {
+            region.setHolder(port, line, true);
+        }
+        DPRINTF(SnoopFilter, "%s:   new SF region value %x.%x\n",
+                __func__, region.requestedPorts(), region.holderPorts());
+        return;
+    }
+
     // next check if we actually allocated an entry
     Addr line_addr = cpkt->getBlockAddr(linesize);
     if (cpkt->isSecure()) {
@@ -414,6 +668,24 @@ SnoopFilter::regStats()
         .name(name() + ".hit_multi_snoops")
         .desc("Number of snoops hitting in the snoop filter with multiple "\
               "(>1) holders of the requested data.");
+
+    snoopTargets
+        .name(name() + ".snoop_targets")
+        .desc("Number of ports snooped after filtering.");
+
+    snoopCandidates
+        .name(name() + ".snoop_candidates")
+        .desc("Number of ports a broadcast would have snooped.");
+
+    snoopReduction
+        .name(name() + ".snoop_reduction")
+        .desc("Fraction of broadcast snoops removed by the filter.");
+    snoopReduction = (snoopCandidates - snoopTargets) / snoopCandidates;
+
+    lookupRate
+        .name(name() + ".lookup_rate")
+        .desc("Snoop filter lookups per simulated second.");
+    lookupRate = (totRequests + totSnoops) / simSeconds;
 }
 
 SnoopFilter *
@@ -47,10 +47,13 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_region.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -83,6 +86,17 @@
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * Optionally, the filter groups its entries by coarse-grained regions
+ * (region_size > 0), in the spirit of RegionScout. The map then holds
+ * one SnoopRegion per region rather than one entry per line. It keeps
+ * the lines every port requested and holds as bitmaps, and the ports
+ * interested in any line of the region as masks. Requests to private
+ * data hit a region only the requester is interested in and are
+ * settled from the masks alone. Otherwise only the line state of the
+ * interested ports is checked, so snoops go to the same ports as in
+ * the line mode, and a region is forgotten once none of its lines is
+ * cached above.
  */
 class SnoopFilter : public SimObject {
   public:
@@ -90,9 +104,17 @@ class SnoopFilter : public SimObject {
 
     SnoopFilter (const SnoopFilterParams *p) :
         SimObject(p), reqLookupResult(cachedLocations.end()), retryItem{0, 0},
+        regionLookupResult(cachedRegions.end()), retryRegionPort(-1),
         linesize(p->system->cacheLineSize()), lookupLatency(p->lookup_latency),
-        maxEntryCount(p->max_capacity / p->system->cacheLineSize())
+        maxEntryCount(p->max_capacity / p->system->cacheLineSize()),
+        regionSize(p->region_size)
     {
+        fatal_if(regionSize && (!isPowerOf2(regionSize) ||
+                                regionSize < linesize ||
+                                regionSize / linesize > SnoopRegion::MaxLines),
+                 "Snoop filter region size %d must be a power of two "
+                 "between one and %d cache lines\n", regionSize,
+                 SnoopRegion::MaxLines);
     }
 
     /**
@@ -192,6 +214,9 @@ class SnoopFilter : public SimObject {
      */
     void updateResponse(const Packet *cpkt, const SlavePort& slave_port);
 
+    /** Does the filter track regions rather than individual lines? */
+    bool tracksRegions() const { return regionSize != 0; }
+
     virtual void regStats();
 
   protected:
@@ -220,6 +245,11 @@ class SnoopFilter : public SimObject {
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
+    /**
+     * HashMap of SnoopRegions indexed by region address
+     */
+    typedef std::unordered_map<Addr, SnoopRegion> RegionFilterCache;
+
     /**
      * Simple factory methods for standard return values.
      */
@@ -258,6 +288,26 @@ class SnoopFilter : public SimObject {
      */
     void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
 
+    /** Line and region flavours of lookupRequest and lookupSnoop. */
+    std::pair<SnoopList, Cycles> lookupRequestLine(const Packet* cpkt,
+                                                   const SlavePort& slave_port);
+    std::pair<SnoopList, Cycles> lookupRequestRegion(const Packet* cpkt,
+                                                     const SlavePort& slave_port);
+    std::pair<SnoopList, Cycles> lookupSnoopLine(const Packet* cpkt);
+    std::pair<SnoopList, Cycles> lookupSnoopRegion(const Packet* cpkt);
+
+    /** Offset of the line of a packet within its region. */
+    unsigned regionLine(const Packet* cpkt) const;
+
+    /** Index of a snooping port in the region line state. */
+    unsigned regionPort(const SlavePort& port) const;
+
+    /** Remove a region none of whose lines is tracked anymore. */
+    void eraseIfNullRegion(RegionFilterCache::iterator& region_it);
+
+    /** Region address of a packet, including the secure bit. */
+    Addr regionAddr(const Packet* cpkt) const;
+
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
     /**
@@ -271,6 +321,16 @@ class SnoopFilter : public SimObject {
      * (because of crossbar retry)
      */
     SnoopItem retryItem;
+    /** Simple hash map of the tracked regions. */
+    RegionFilterCache cachedRegions;
+    /** Region counterpart of reqLookupResult. */
+    RegionFilterCache::iterator regionLookupResult;
+    /**
+     * Port whose previous lines are held in retryRegionLines after a
+     * region lookupRequest, or -1 if it did not change anything.
+     */
+    int retryRegionPort;
+    SnoopRegion::PortLines retryRegionLines;
     /** List of all attached snooping slave ports. */
     SnoopList slavePorts;
     /** Track the mapping from port ids to the local mask ids. */
@@ -281,6 +341,8 @@ class SnoopFilter : public SimObject {
     const Cycles lookupLatency;
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
+    /** Tracking granularity in bytes, zero when tracking lines */
+    const unsigned regionSize;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -298,6 +360,11 @@ class SnoopFilter : public SimObject {
     Stats::Scalar totSnoops;
     Stats::Scalar hitSingleSnoops;
     Stats::Scalar hitMultiSnoops;
+
+    Stats::Scalar snoopTargets;
+    Stats::Scalar snoopCandidates;
+    Stats::Formula snoopReduction;
+    Stats::Formula lookupRate;
 };
 
 inline SnoopFilter::SnoopMask
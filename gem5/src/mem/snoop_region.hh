@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Tracking state of one coarse-grained region of the snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_REGION_HH__
+#define __MEM_SNOOP_REGION_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+/**
+ * A region entry of the snoop filter. For every snooping port it keeps
+ * a bitmap of the lines of the region the port has requested, and one
+ * of the lines it holds, so line-level questions are answered exactly.
+ * On top, it keeps the ports that request or hold any line of the
+ * region as two masks, updated as the bitmaps change. Requests to a
+ * region only the requester is interested in, the common case for
+ * private data, are then settled from the masks without looking at
+ * any line, and the line state of the other ports is only visited for
+ * the ports in the masks.
+ *
+ * The entry takes two bitmaps per port whatever the number of lines,
+ * so a region with several lines cached is much smaller than the line
+ * entries it replaces.
+ */
+class SnoopRegion
+{
+  public:
+    /** Bitmask of snooping ports, indexed by local port id */
+    typedef uint64_t SnoopMask;
+    /** Bitmap of the lines of a region, indexed by line offset */
+    typedef uint64_t LineMask;
+
+    /** Largest number of lines a region may span. */
+    static const unsigned MaxLines = 8 * sizeof(LineMask);
+
+    /** The requested and held lines of one port. */
+    typedef std::pair<LineMask, LineMask> PortLines;
+
+    explicit SnoopRegion(unsigned num_ports)
+        : requested(0), holder(0), lines(num_ports, PortLines(0, 0))
+    {}
+
+    /** Ports with an outstanding request to any line of the region. */
+    SnoopMask requestedPorts() const { return requested; }
+    /** Ports holding any line of the region. */
+    SnoopMask holderPorts() const { return holder; }
+    /** Ports interested in any line of the region. */
+    SnoopMask interest() const { return requested | holder; }
+    /** Is no line of the region requested or held anymore? */
+    bool empty() const { return !interest(); }
+
+    bool
+    requests(unsigned port, unsigned line) const
+    {
+        return lines[port].first & lineBit(line);
+    }
+
+    bool
+    holds(unsigned port, unsigned line) const
+    {
+        return lines[port].second & lineBit(line);
+    }
+
+    /** Ports with an outstanding request to a line, out of candidates. */
+    SnoopMask
+    lineRequested(unsigned line, SnoopMask candidates = ~SnoopMask(0)) const
+    {
+        SnoopMask res = 0;
+        for (SnoopMask m = requested & candidates; m; m &= m - 1) {
+            unsigned port = findLsbSet(m);
+            if (requests(port, line))
+                res |= portBit(port);
+        }
+        return res;
+    }
+
+    /** Ports holding a line, out of candidates. */
+    SnoopMask
+    lineHolder(unsigned line, SnoopMask candidates = ~SnoopMask(0)) const
+    {
+        SnoopMask res = 0;
+        for (SnoopMask m = holder & candidates; m; m &= m - 1) {
+            unsigned port = findLsbSet(m);
+            if (holds(port, line))
+                res |= portBit(port);
+        }
+        return res;
+    }
+
+    /** Ports requesting or holding a line, out of candidates. */
+    SnoopMask
+    lineInterest(unsigned line, SnoopMask candidates = ~SnoopMask(0)) const
+    {
+        // Only ports interested in the region can be interested in
+        // the line, which settles private regions right away
+        if (!(interest() & candidates))
+            return 0;
+        return lineRequested(line, candidates) | lineHolder(line, candidates);
+    }
+
+    void
+    setRequested(unsigned port, unsigned line, bool set)
+    {
+        update(port, lines[port].first, line, set, requested);
+    }
+
+    void
+    setHolder(unsigned port, unsigned line, bool set)
+    {
+        update(port, lines[port].second, line, set, holder);
+    }
+
+    /** Forget all holders of a line. */
+    void
+    clearHolders(unsigned line)
+    {
+        for (SnoopMask m = holder; m; m &= m - 1)
+            setHolder(findLsbSet(m), line, false);
+    }
+
+    /** State of a port, to undo changes to it. */
+    PortLines portLines(unsigned port) const { return lines[port]; }
+
+    void
+    setPortLines(unsigned port, const PortLines &port_lines)
+    {
+        lines[port] = port_lines;
+        requested = setPort(requested, port, port_lines.first);
+        holder = setPort(holder, port, port_lines.second);
+    }
+
+    /** Bytes taken by the entry, excluding the map holding it. */
+    size_t
+    footprint() const
+    {
+        return sizeof(*this) + lines.capacity() * sizeof(PortLines);
+    }
+
+  private:
+    static LineMask lineBit(unsigned line) { return LineMask(1) << line; }
+    static SnoopMask portBit(unsigned port) { return SnoopMask(1) << port; }
+
+    static SnoopMask
+    setPort(SnoopMask mask, unsigned port, LineMask port_lines)
+    {
+        return port_lines ? mask | portBit(port) : mask & ~portBit(port);
+    }
+
+    static void
+    update(unsigned port, LineMask &port_lines, unsigned line, bool set,
+           SnoopMask &ports)
+    {
+        if (set)
+            port_lines |= lineBit(line);
+        else
+            port_lines &= ~lineBit(line);
+        ports = setPort(ports, port, port_lines);
+    }
+
+    /** Ports with a bit set in their requested / held bitmaps */
+    SnoopMask requested;
+    SnoopMask holder;
+
+    /** Requested and held lines of every port */
+    std::vector<PortLines> lines;
+};
+
+#endif // __MEM_SNOOP_REGION_HH__
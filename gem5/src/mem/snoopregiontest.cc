@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+#include "mem/snoop_region.hh"
+
+TEST(SnoopRegionTest, Empty)
+{
+    SnoopRegion region(4);
+    EXPECT_TRUE(region.empty());
+    EXPECT_EQ(region.interest(), 0);
+    EXPECT_EQ(region.lineInterest(3), 0);
+}
+
+TEST(SnoopRegionTest, LineState)
+{
+    SnoopRegion region(4);
+    region.setRequested(1, 5, true);
+    EXPECT_EQ(region.requestedPorts(), 0x2);
+    EXPECT_TRUE(region.requests(1, 5));
+    EXPECT_FALSE(region.requests(1, 4));
+
+    // The response turns the request into a copy
+    region.setRequested(1, 5, false);
+    region.setHolder(1, 5, true);
+    region.setHolder(2, 5, true);
+    region.setHolder(2, 6, true);
+    EXPECT_EQ(region.requestedPorts(), 0);
+    EXPECT_EQ(region.holderPorts(), 0x6);
+
+    // Line queries only name the ports holding that very line
+    EXPECT_EQ(region.lineHolder(5), 0x6);
+    EXPECT_EQ(region.lineHolder(6), 0x4);
+    EXPECT_EQ(region.lineInterest(6, ~0x4ULL), 0);
+    EXPECT_EQ(region.lineInterest(5, ~0x4ULL), 0x2);
+
+    // A port stays in the region as long as it holds any line of it
+    region.setHolder(2, 5, false);
+    EXPECT_EQ(region.holderPorts(), 0x6);
+    region.setHolder(2, 6, false);
+    EXPECT_EQ(region.holderPorts(), 0x2);
+
+    region.clearHolders(5);
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(SnoopRegionTest, UndoPortChanges)
+{
+    SnoopRegion region(2);
+    region.setHolder(0, 1, true);
+    SnoopRegion::PortLines saved = region.portLines(0);
+
+    region.setRequested(0, 2, true);
+    region.setHolder(0, 1, false);
+    EXPECT_EQ(region.holderPorts(), 0);
+
+    region.setPortLines(0, saved);
+    EXPECT_TRUE(region.holds(0, 1));
+    EXPECT_FALSE(region.requests(0, 2));
+    EXPECT_EQ(region.requestedPorts(), 0);
+    EXPECT_EQ(region.holderPorts(), 0x1);
+}
+
+namespace {
+
+/** Line mode entry, as kept by the snoop filter */
+struct LineItem
+{
+    uint64_t requested;
+    uint64_t holder;
+};
+
+/** Bytes of a hash map: its nodes, each with a next pointer, and buckets */
+template <class Map>
+size_t
+mapBytes(const Map &map)
+{
+    return map.size() * (sizeof(typename Map::value_type) + sizeof(void *)) +
+        map.bucket_count() * sizeof(void *);
+}
+
+} // anonymous namespace
+
+/**
+ * Four ports filling and then evicting private working sets of 64kB,
+ * tracked per 64B line and per 1kB region. The region map holds a
+ * sixteenth of the entries, in a fraction of the memory, and is
+ * updated a sixteenth as often. Every request of a port is settled from
+ * the region masks, without visiting any line.
+ */
+TEST(SnoopRegionTest, PrivateDataSaving)
+{
+    const unsigned ports = 4;
+    const unsigned line_size = 64;
+    const unsigned region_size = 1024;
+    const unsigned lines_per_region = region_size / line_size;
+    const unsigned lines_per_port = 1024;
+
+    std::unordered_map<uint64_t, LineItem> line_map;
+    std::unordered_map<uint64_t, SnoopRegion> region_map;
+    unsigned line_updates = 0, region_updates = 0;
+    unsigned snooped = 0;
+
+    for (unsigned p = 0; p < ports; p++) {
+        uint64_t base = (uint64_t)p << 32;
+        for (unsigned l = 0; l < lines_per_port; l++) {
+            uint64_t addr = base + l * line_size;
+
+            auto line_it = line_map.find(addr);
+            if (line_it == line_map.end()) {
+                line_it = line_map.emplace(addr, LineItem{0, 0}).first;
+                line_updates++;
+            }
+            line_it->second.holder |= 1ULL << p;
+
+            uint64_t region_addr = addr & ~uint64_t(region_size - 1);
+            auto region_it = region_map.find(region_addr);
+            if (region_it == region_map.end()) {
+                region_it = region_map.emplace(region_addr,
+                                               SnoopRegion(ports)).first;
+                region_updates++;
+            }
+            unsigned line = (addr % region_size) / line_size;
+            if (region_it->second.lineInterest(line, ~(1ULL << p)))
+                snooped++;
+            region_it->second.setHolder(p, line, true);
+        }
+    }
+
+    EXPECT_EQ(snooped, 0);
+    EXPECT_EQ(line_map.size(), ports * lines_per_port);
+    EXPECT_EQ(region_map.size(), ports * lines_per_port / lines_per_region);
+
+    size_t line_bytes = mapBytes(line_map);
+    size_t region_bytes = mapBytes(region_map);
+    for (const auto &kv : region_map) {
+        region_bytes += kv.second.footprint() - sizeof(SnoopRegion);
+        EXPECT_EQ(kv.second.interest(),
+                  1ULL << (kv.first >> 32)) << std::hex << kv.first;
+    }
+    EXPECT_LT(region_bytes * 4, line_bytes)
+        << "line mode " << line_bytes << " bytes, region mode "
+        << region_bytes << " bytes";
+
+    // Evict everything again, each map entry is erased once
+    for (unsigned p = 0; p < ports; p++) {
+        uint64_t base = (uint64_t)p << 32;
+        for (unsigned l = 0; l < lines_per_port; l++) {
+            uint64_t addr = base + l * line_size;
+            if (line_map.erase(addr))
+                line_updates++;
+
+            uint64_t region_addr = addr & ~uint64_t(region_size - 1);
+            auto region_it = region_map.find(region_addr);
+            region_it->second.setHolder(p, (addr % region_size) / line_size,
+                                        false);
+            if (region_it->second.empty()) {
+                region_map.erase(region_it);
+                region_updates++;
+            }
+        }
+    }
+
+    EXPECT_TRUE(line_map.empty());
+    EXPECT_TRUE(region_map.empty());
+    EXPECT_EQ(line_updates, region_updates * lines_per_region);
+}
@@ -105,6 +105,14 @@ def parse_options():
     group("Statistics Options")
     option("--stats-file", metavar="FILE", default="stats.txt",
         help="Sets the output file for statistics [Default: %default]")
+    option("--stats-watch", metavar="STAT[,STAT]", action='append',
+        split=',',
+        help="Sample these stats periodically (see --stats-sample-period)")
+    option("--stats-sample-period", metavar="TICKS", type='int', default=0,
+        help="Period at which the watched stats are sampled")
+    option("--stats-sample-file", metavar="FILE",
+        default="stats_samples.txt",
+        help="Sets the output file for the stat samples [Default: %default]")
 
     # Configuration Options
     group("Configuration Options")
@@ -117,6 +125,8 @@ def parse_options():
     option("--dot-dvfs-config", metavar="FILE", default=None,
         help="Create DOT & pdf outputs of the DVFS configuration" + \
              " [Default: %default]")
+    option("--startup-breakdown", action="store_true", default=False,
+        help="Print the time spent in each phase of instantiation")
 
     # Debugging options
     group("Debugging Options")
@@ -133,10 +143,17 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-format", metavar="{text,binary}", default="text",
+        choices=["text", "binary"],
+        help="Write debug output as text or as a binary trace, decoded " \
+             "by util/decode_binary_trace.py [Default: %default]")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
         help="Remote gdb base port (set to 0 to disable listening)")
+    option("--event-profile", metavar="FILE", default=None,
+        help="Write the host time spent per SimObject and event to FILE " \
+             "at every stats dump and at exit")
 
     # Help options
     group("Help Options")
@@ -343,6 +360,10 @@ def main(*args):
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.stats_watch and options.stats_sample_period:
+        stats.periodicStatSample(options.stats_sample_period,
+                                 options.stats_watch,
+                                 filename=options.stats_sample_file)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -397,12 +418,21 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_format == "binary":
+        check_tracing()
+        if options.debug_file in ("cout", "stdout", "cerr", "stderr"):
+            fatal("Binary debug output needs a --debug-file")
+        trace.binaryOutput(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         check_tracing()
         trace.ignore(ignore)
 
+    if options.event_profile:
+        event.enableProfiling(options.event_profile)
+
     sys.argv = arguments
     sys.path = [ os.path.dirname(sys.argv[0]) ] + sys.path
 
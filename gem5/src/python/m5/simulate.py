@@ -45,6 +45,7 @@ from __future__ import print_function
 import atexit
 import os
 import sys
+import time
 
 # import the wrapped C++ functions
 import _m5.drain
@@ -71,6 +72,24 @@ _memory_modes = {
 
 _drain_manager = _m5.drain.DrainManager.instance()
 
+class _StartupTimer(object):
+    """Wall-clock time spent in each phase of instantiate()"""
+    def __init__(self):
+        self.phases = []
+        self.last = time.time()
+
+    def phase(self, name):
+        now = time.time()
+        self.phases.append((name, now - self.last))
+        self.last = now
+
+    def report(self, num_objects):
+        total = sum(t for n, t in self.phases)
+        print("Startup breakdown for %d SimObjects:" % num_objects)
+        for name, t in self.phases:
+            print("  %-22s %8.3f s" % (name, t))
+        print("  %-22s %8.3f s" % ("instantiate total", total))
+
 # The final hook to generate .ini files.  Called from the user script
 # once the config is built.
 def instantiate(ckpt_dir=None):
@@ -84,19 +103,29 @@ def instantiate(ckpt_dir=None):
     # we need to fix the global frequency
     ticks.fixGlobalFrequency()
 
+    timer = _StartupTimer()
+
     # Make sure SimObject-valued params are in the configuration
     # hierarchy so we catch them with future descendants() walks
     for obj in root.descendants(): obj.adoptOrphanParams()
+    timer.phase("adopt orphan params")
+
+    # The hierarchy does not change from here on, so walk it once and
+    # reuse the result for all the passes below
+    descendants = list(root.descendants())
+    timer.phase("walk hierarchy")
 
     # Unproxy in sorted order for determinism
-    for obj in root.descendants(): obj.unproxyParams()
+    for obj in descendants: obj.unproxyParams()
+    timer.phase("unproxy params")
 
     if options.dump_config:
         ini_file = file(os.path.join(options.outdir, options.dump_config), 'w')
         # Print ini sections in sorted order for easier diffing
-        for obj in sorted(root.descendants(), key=lambda o: o.path()):
+        for obj in sorted(descendants, key=lambda o: o.path()):
             obj.print_ini(ini_file)
         ini_file.close()
+        timer.phase("dump ini")
 
     if options.json_config:
         try:
@@ -107,50 +136,64 @@ def instantiate(ckpt_dir=None):
             json_file.close()
         except ImportError:
             pass
+        timer.phase("dump json")
 
     do_dot(root, options.outdir, options.dot_config)
+    timer.phase("dump dot")
 
     # Initialize the global statistics
     stats.initSimStats()
 
     # Create the C++ sim objects and connect ports
-    for obj in root.descendants(): obj.createCCObject()
-    for obj in root.descendants(): obj.connectPorts()
+    for obj in descendants: obj.createCCObject()
+    timer.phase("create C++ objects")
+    for obj in descendants: obj.connectPorts()
+    timer.phase("connect ports")
 
     # Do a second pass to finish initializing the sim objects
-    for obj in root.descendants(): obj.init()
+    for obj in descendants: obj.init()
+    timer.phase("init")
 
     # Do a third pass to initialize statistics
-    for obj in root.descendants(): obj.regStats()
+    for obj in descendants: obj.regStats()
+    timer.phase("register stats")
 
     # Do a fourth pass to initialize probe points
-    for obj in root.descendants(): obj.regProbePoints()
+    for obj in descendants: obj.regProbePoints()
 
     # Do a fifth pass to connect probe listeners
-    for obj in root.descendants(): obj.regProbeListeners()
+    for obj in descendants: obj.regProbeListeners()
+    timer.phase("register probes")
 
     # We want to generate the DVFS diagram for the system. This can only be
     # done once all of the CPP objects have been created and initialised so
     # that we are able to figure out which object belongs to which domain.
     if options.dot_dvfs_config:
         do_dvfs_dot(root, options.outdir, options.dot_dvfs_config)
+        timer.phase("dump dvfs dot")
 
     # We're done registering statistics.  Enable the stats package now.
     stats.enable()
+    timer.phase("enable stats")
 
     # Restore checkpoint (if any)
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
         ckpt = _m5.core.getCheckpoint(ckpt_dir)
         _m5.core.unserializeGlobals(ckpt);
-        for obj in root.descendants(): obj.loadState(ckpt)
+        for obj in descendants: obj.loadState(ckpt)
+        timer.phase("restore checkpoint")
     else:
-        for obj in root.descendants(): obj.initState()
+        for obj in descendants: obj.initState()
+        timer.phase("init state")
 
     # Check to see if any of the stat events are in the past after resuming from
     # a checkpoint, If so, this call will shift them to be at a valid time.
     updateStatEvents()
 
+    if options.startup_breakdown:
+        timer.report(len(descendants))
+
 need_startup = True
 def simulate(*args, **kwargs):
     global need_startup
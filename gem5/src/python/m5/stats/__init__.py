@@ -49,6 +49,7 @@ from m5.util import attrdict, fatal
 # Stat exports
 from _m5.stats import schedStatEvent as schedEvent
 from _m5.stats import periodicStatDump
+from _m5.stats import periodicStatSample
 
 outputList = []
 
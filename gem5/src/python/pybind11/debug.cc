@@ -48,9 +48,11 @@
 #include <map>
 #include <vector>
 
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -70,6 +72,28 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    OutputStream *file_stream = simout.create(filename, true);
+
+    // A forked child continues the trace of its parent in its own file
+    Trace::BinaryLogger *current =
+        dynamic_cast<Trace::BinaryLogger *>(Trace::getDebugLogger());
+    if (current) {
+        current->redirect(*file_stream->stream());
+        return;
+    }
+
+    Trace::BinaryLogger *logger =
+        new Trace::BinaryLogger(*file_stream->stream());
+
+    Trace::setDebugLogger(logger);
+    registerExitCallback(
+        new MakeCallback<Trace::BinaryLogger, &Trace::BinaryLogger::flush>(
+            logger));
+}
+
 static void
 ignore(const char *expr)
 {
@@ -112,6 +136,7 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
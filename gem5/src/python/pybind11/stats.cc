@@ -81,6 +81,10 @@ pybind_init_stats(py::module &m_native)
              &Stats::registerPythonStatsHandlers)
         .def("schedStatEvent", &Stats::schedStatEvent)
         .def("periodicStatDump", &Stats::periodicStatDump)
+        .def("periodicStatSample", &Stats::periodicStatSample,
+             py::arg("period"), py::arg("names"),
+             py::arg("capacity") = 4096,
+             py::arg("filename") = "stats_samples.txt")
         .def("updateEvents", &Stats::updateEvents)
         .def("processResetQueue", &Stats::processResetQueue)
         .def("processDumpQueue", &Stats::processDumpQueue)
@@ -68,6 +68,12 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Host NUMA node for each main event queue, by index. The thread
+    # simulating a queue runs on that node, and the backing store of
+    # the memories it owns is placed there.
+    eventq_host_nodes = VectorParam.Int([], "host NUMA node of each " \
+                                        "event queue")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
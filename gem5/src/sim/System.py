@@ -51,6 +51,10 @@ from SimpleMemory import *
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+# Host pages backing the simulated memory: normal pages, transparent
+# huge pages (madvise), or explicitly reserved huge pages (hugetlbfs)
+class HostHugePages(Enum): vals = ['normal', 'transparent', 'hugetlb']
+
 class System(MemObject):
     type = 'System'
     cxx_header = "sim/system.hh"
@@ -76,6 +80,22 @@ class System(MemObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    # Large simulated memories see many host TLB misses on the
+    # backing store; huge pages reduce them. Explicit huge pages have
+    # to be reserved on the host (vm.nr_hugepages), and fall back to
+    # transparent huge pages when there are not enough.
+    mmap_huge_pages = Param.HostHugePages('normal', "Host pages to back " \
+                                          "the memory with")
+
+    # Functional accesses from port proxies (syscall emulation, loaders)
+    # normally travel through the memory system one cache line at a
+    # time so that they see data held in caches. Without caches, and
+    # in atomic mode where nothing is in flight, they can safely be
+    # done as a memcpy on the backing store instead.
+    functional_backdoor = Param.Bool(False, "Let port proxies access the " \
+                                         "backing store directly in " \
+                                         "atomic mode (no caches only)")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
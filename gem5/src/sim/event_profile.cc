@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2025 The gem5 Project contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profile.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "base/callback.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace EventProfile {
+
+bool enabled = false;
+
+namespace {
+
+struct Entry
+{
+    Entry() : time(0), count(0) {}
+
+    void
+    add(const Entry &other)
+    {
+        time += other.time;
+        count += other.count;
+    }
+
+    uint64_t time;
+    uint64_t count;
+};
+
+/** The accumulators of one thread. */
+struct ThreadTable
+{
+    /** The accumulators, one per interned event name. */
+    std::unordered_map<std::string, Entry> byName;
+
+    /**
+     * Events that outlive their invocation, mapped to the accumulator
+     * of their name on first use so the hot path never builds a string.
+     * An event leaves the map when it is destroyed, so a new event at
+     * the same address is named afresh.
+     */
+    std::unordered_map<const Event *, Entry *> byEvent;
+};
+
+std::mutex tablesLock;
+std::vector<ThreadTable *> tables;
+thread_local ThreadTable *localTable = nullptr;
+
+typedef std::map<std::string, Entry> Totals;
+
+OutputStream *output = nullptr;
+Totals lastDump;
+Tick lastDumpTick = 0;
+
+uint64_t startStamp;
+std::chrono::steady_clock::time_point startTime;
+
+ThreadTable &
+threadTable()
+{
+    if (!localTable) {
+        localTable = new ThreadTable;
+        std::lock_guard<std::mutex> lock(tablesLock);
+        tables.push_back(localTable);
+    }
+    return *localTable;
+}
+
+/**
+ * The event as a function wrapper, whose name is known without
+ * building it. Derived classes may name themselves differently.
+ */
+const EventFunctionWrapper *
+functionWrapper(const Event *event)
+{
+    return typeid(*event) == typeid(EventFunctionWrapper) ?
+        static_cast<const EventFunctionWrapper *>(event) : nullptr;
+}
+
+/** The event name without the suffix added by the event wrappers. */
+std::string
+label(const Event *event)
+{
+    if (const EventFunctionWrapper *wrapper = functionWrapper(event))
+        return wrapper->baseName();
+
+    std::string name = event->name();
+    for (const std::string suffix :
+             { ".wrapped_function_event", ".wrapped_event" }) {
+        if (name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(),
+                         suffix) == 0) {
+            name.resize(name.size() - suffix.size());
+            break;
+        }
+    }
+    return name;
+}
+
+/** The longest prefix of an event name that names a SimObject. */
+const std::string &
+owner(const std::string &name)
+{
+    static std::map<std::string, std::string> owners;
+    auto it = owners.find(name);
+    if (it != owners.end())
+        return it->second;
+
+    std::string prefix = name;
+    while (!SimObject::find(prefix.c_str())) {
+        size_t dot = prefix.rfind('.');
+        if (dot == std::string::npos) {
+            prefix = "(no SimObject)";
+            break;
+        }
+        prefix.resize(dot);
+    }
+    return owners[name] = prefix;
+}
+
+/**
+ * Sum the accumulators of all threads. This only runs at stats dumps
+ * and at exit, when the event queues are not running.
+ */
+Totals
+collect()
+{
+    Totals totals;
+    std::lock_guard<std::mutex> lock(tablesLock);
+    for (auto table : tables) {
+        for (const auto &kv : table->byName)
+            totals[kv.first].add(kv.second);
+    }
+    return totals;
+}
+
+/** Host nanoseconds per time stamp unit, measured over the run. */
+double
+nsPerUnit()
+{
+    uint64_t units = timestamp() - startStamp;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return units ? double(ns) / units : 0.0;
+}
+
+void
+writeRanking(std::ostream &os, const char *what, const Totals &totals,
+             uint64_t total_time, double ns_per_unit)
+{
+    std::vector<Totals::const_iterator> ranked;
+    for (auto it = totals.begin(); it != totals.end(); ++it) {
+        if (it->second.count)
+            ranked.push_back(it);
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [](Totals::const_iterator a, Totals::const_iterator b) {
+                  return a->second.time > b->second.time;
+              });
+
+    os << std::setw(14) << "host_seconds" << std::setw(9) << "share"
+       << std::setw(14) << "events" << std::setw(12) << "ns/event"
+       << "  " << what << "\n";
+    for (auto it : ranked) {
+        const Entry &e = it->second;
+        double ns = e.time * ns_per_unit;
+        os << std::fixed << std::setprecision(6) << std::setw(14)
+           << ns / 1e9 << std::setprecision(2) << std::setw(8)
+           << (total_time ? 100.0 * e.time / total_time : 0.0) << "%"
+           << std::setw(14) << e.count << std::setw(12) << ns / e.count
+           << "  " << it->first << "\n";
+    }
+    os << "\n";
+}
+
+void
+writeReport(const std::string &title, const Totals &events)
+{
+    std::ostream &os = *output->stream();
+    double ns_per_unit = nsPerUnit();
+
+    Totals owners;
+    Entry total;
+    for (const auto &kv : events) {
+        owners[owner(kv.first)].add(kv.second);
+        total.add(kv.second);
+    }
+
+    os << "---------- Begin " << title << " ----------\n"
+       << "events serviced: " << total.count << "\n"
+       << "host seconds in events: " << std::fixed << std::setprecision(6)
+       << total.time * ns_per_unit / 1e9 << "\n\n";
+    writeRanking(os, "owner", owners, total.time, ns_per_unit);
+    writeRanking(os, "event", events, total.time, ns_per_unit);
+    os << "---------- End " << title << " ----------\n\n";
+    os.flush();
+}
+
+/** Report the interval since the previous stats dump. */
+class DumpCallback : public Callback
+{
+  public:
+    void
+    process() override
+    {
+        Totals current = collect();
+        Totals delta;
+        for (const auto &kv : current) {
+            Entry e = kv.second;
+            auto last = lastDump.find(kv.first);
+            if (last != lastDump.end()) {
+                e.time -= last->second.time;
+                e.count -= last->second.count;
+            }
+            if (e.count)
+                delta[kv.first] = e;
+        }
+        lastDump.swap(current);
+
+        std::ostringstream title;
+        title << "Event Profile Delta (ticks " << lastDumpTick << " to "
+              << curTick() << ")";
+        lastDumpTick = curTick();
+        writeReport(title.str(), delta);
+    }
+};
+
+/** Report the whole run. */
+class ExitCallback : public Callback
+{
+  public:
+    void process() override { writeReport("Event Profile", collect()); }
+};
+
+} // anonymous namespace
+
+void
+enable(const std::string &filename)
+{
+    fatal_if(enabled, "Event profiling enabled twice\n");
+
+    output = simout.create(filename);
+    startStamp = timestamp();
+    startTime = std::chrono::steady_clock::now();
+
+    Stats::registerDumpCallback(new DumpCallback);
+    registerExitCallback(new ExitCallback);
+    enabled = true;
+}
+
+void
+record(const Event *event, uint64_t elapsed)
+{
+    ThreadTable &table = threadTable();
+    Entry *entry;
+    if (event->isAutoDelete()) {
+        // Most auto-deleted events are function wrappers, whose name
+        // is only copied the first time it is seen.
+        const EventFunctionWrapper *wrapper = functionWrapper(event);
+        entry = wrapper ? &table.byName[wrapper->baseName()] :
+            &table.byName[label(event)];
+    } else {
+        Entry *&cached = table.byEvent[event];
+        if (!cached)
+            cached = &table.byName[label(event)];
+        entry = cached;
+    }
+    entry->time += elapsed;
+    entry->count++;
+}
+
+void
+forget(const Event *event)
+{
+    // Events are destroyed by the thread servicing them, or while the
+    // event queues are stopped, so no other thread is recording.
+    if (localTable && localTable->byEvent.erase(event))
+        return;
+    std::lock_guard<std::mutex> lock(tablesLock);
+    for (auto table : tables)
+        table->byEvent.erase(event);
+}
+
+} // namespace EventProfile
@@ -43,12 +43,15 @@
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 #include "sim/core.hh"
+#include "sim/event_profile.hh"
 #include "sim/eventq_impl.hh"
 
 using namespace std;
 
 Tick simQuantum = 0;
 
+std::vector<int> eventqHostNodes;
+
 //
 // Main Event Queues
 //
@@ -79,6 +82,8 @@ Counter Event::instanceCounter = 0;
 Event::~Event()
 {
     assert(!scheduled());
+    if (EventProfile::enabled && !isAutoDelete())
+        EventProfile::forget(this);
     flags = 0;
 }
 
@@ -225,7 +230,13 @@ EventQueue::serviceOne()
         // forward current cycle to the time when this event occurs.
         setCurTick(event->when());
 
-        event->process();
+        if (EventProfile::enabled) {
+            uint64_t start = EventProfile::timestamp();
+            event->process();
+            EventProfile::record(event, EventProfile::timestamp() - start);
+        } else {
+            event->process();
+        }
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -46,6 +46,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "base/flags.hh"
 #include "base/types.hh"
@@ -62,6 +63,11 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Host NUMA node to run each main event queue on, and to place the
+//! backing store of the memories it owns on. Queues beyond the end
+//! are not bound to a node.
+extern std::vector<int> eventqHostNodes;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -834,6 +840,9 @@ class EventFunctionWrapper : public Event
         return _name + ".wrapped_function_event";
     }
 
+    /** The name given at construction, without the suffix */
+    const std::string &baseName() const { return _name; }
+
     const char *description() const { return "EventFunctionWrapped"; }
 };
 
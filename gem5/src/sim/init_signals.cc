@@ -58,6 +58,7 @@
 #include "base/atomicio.hh"
 #include "base/cprintf.hh"
 #include "base/logging.hh"
+#include "base/trace.hh"
 #include "sim/async.hh"
 #include "sim/backtrace.hh"
 #include "sim/core.hh"
@@ -153,6 +154,11 @@ abortHandler(int sigtype)
         STATIC_ERR("Program aborted\n\n");
     }
 
+    // Keep the debug output leading up to a panic. Other event queue
+    // threads may still be logging, so their buffers are only taken
+    // with a single queue, and nothing waits on a lock they hold.
+    Trace::flushDebugLoggerOnAbort(numMainEventQueues == 1);
+
     print_backtrace();
     raiseFatalSignal(sigtype);
 }
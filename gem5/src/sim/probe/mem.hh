@@ -57,6 +57,7 @@ struct PacketInfo {
     uint32_t size;
     Request::FlagsType flags;
     Addr pc;
+    Addr vaddr;
     MasterID master;
 
     explicit PacketInfo(const PacketPtr& pkt) :
@@ -65,6 +66,7 @@ struct PacketInfo {
         size(pkt->getSize()),
         flags(pkt->req->getFlags()),
         pc(pkt->req->hasPC() ? pkt->req->getPC() : 0),
+        vaddr(pkt->req->hasVaddr() ? pkt->req->getVaddr() : 0),
         master(pkt->req->masterId())  { }
 };
 
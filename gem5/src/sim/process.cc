@@ -257,6 +257,31 @@ Process::regStats()
         .name(name() + ".numSyscalls")
         .desc("Number of system calls")
         ;
+
+    pageTableLookups
+        .method(this, &Process::ptLookups)
+        .name(name() + ".pageTableLookups")
+        .desc("Number of page table lookups")
+        ;
+
+    pageTableWalks
+        .method(this, &Process::ptWalks)
+        .name(name() + ".pageTableWalks")
+        .desc("Number of page table lookups that missed the translation "
+              "cache")
+        ;
+}
+
+Counter
+Process::ptLookups() const
+{
+    return pTable->lookups();
+}
+
+Counter
+Process::ptWalks() const
+{
+    return pTable->walks();
 }
 
 ThreadContext *
@@ -173,6 +173,12 @@ class Process : public SimObject
 
     Stats::Scalar numSyscalls;  // track how many system calls are executed
 
+    // page table lookups, and those that walked the table
+    Stats::Value pageTableLookups;
+    Stats::Value pageTableWalks;
+    Counter ptLookups() const;
+    Counter ptWalks() const;
+
     bool useArchPT; // flag for using architecture specific page table
     bool kvmInSE;   // running KVM requires special initialization
 
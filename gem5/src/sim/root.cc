@@ -116,6 +116,12 @@ Root::Root(RootParams *p)
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+
+    // Root is created before the other SimObjects, so the memories
+    // see these when allocating their backing store
+    for (int node : p->eventq_host_nodes)
+        fatal_if(node < 0, "Invalid host NUMA node %d\n", node);
+    eventqHostNodes = p->eventq_host_nodes;
 }
 
 void
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <thread>
 
+#include "base/hostinfo.hh"
 #include "base/logging.hh"
 #include "base/pollevent.hh"
 #include "base/types.hh"
@@ -55,6 +56,18 @@ Barrier *threadBarrier;
 //! forward declaration
 Event *doSimLoop(EventQueue *);
 
+//! Bind the calling thread to the host NUMA node of an event queue,
+//! if one was given.
+static void
+bindEventQueueThread(uint32_t index)
+{
+    if (index < eventqHostNodes.size() &&
+        !bindThreadToHostNode(eventqHostNodes[index])) {
+        warn("Could not bind event queue %d to host NUMA node %d\n",
+             index, eventqHostNodes[index]);
+    }
+}
+
 /**
  * The main function for all subordinate threads (i.e., all threads
  * other than the main thread).  These threads start by waiting on
@@ -64,8 +77,10 @@ Event *doSimLoop(EventQueue *);
  * repeated until the simulation terminates.
  */
 static void
-thread_loop(EventQueue *queue)
+thread_loop(EventQueue *queue, uint32_t index)
 {
+    bindEventQueueThread(index);
+
     while (true) {
         threadBarrier->wait();
         doSimLoop(queue);
@@ -95,8 +110,10 @@ simulate(Tick num_cycles)
         // handles queue 0, so we only need to allocate new threads
         // for queues 1..N-1.  We'll call these the "subordinate" threads.
         for (uint32_t i = 1; i < numMainEventQueues; i++) {
-            threads.push_back(new std::thread(thread_loop, mainEventQueue[i]));
+            threads.push_back(new std::thread(thread_loop, mainEventQueue[i],
+                                              i));
         }
+        bindEventQueueThread(0);
 
         threads_initialized = true;
         simulate_limit_event =
@@ -54,9 +54,11 @@
 
 #include "base/callback.hh"
 #include "base/hostinfo.hh"
+#include "base/output.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "cpu/base.hh"
+#include "sim/core.hh"
 #include "sim/global_event.hh"
 
 using namespace std;
@@ -72,6 +74,7 @@ Time statTime(true);
 Tick startTick;
 
 GlobalEvent *dumpEvent;
+GlobalEvent *sampleEvent;
 
 struct SimTicksReset : public Callback
 {
@@ -284,6 +287,171 @@ periodicStatDump(Tick period)
     }
 }
 
+/**
+ * The watched stats and the buffer their samples are collected in.
+ */
+class StatSampler : public Callback
+{
+  private:
+    /** A watched stat, read as a scalar or as the total of a vector */
+    struct Watched
+    {
+        const ScalarInfo *scalar;
+        const VectorInfo *vector;
+    };
+
+    std::vector<std::string> names;
+    std::vector<Watched> watched;
+
+    /** Sample ticks, and the values of all watched stats per sample */
+    std::vector<Tick> ticks;
+    std::vector<double> values;
+    size_t count;
+
+    std::string filename;
+    OutputStream *output;
+    bool exitRegistered;
+
+    void
+    resolve()
+    {
+        watched.clear();
+        for (const auto &name : names) {
+            auto i = nameMap().find(name);
+            if (i == nameMap().end())
+                fatal("Cannot sample unknown stat '%s'\n", name);
+
+            Watched w;
+            w.scalar = dynamic_cast<const ScalarInfo *>(i->second);
+            w.vector = dynamic_cast<const VectorInfo *>(i->second);
+            if (!w.scalar && !w.vector)
+                fatal("Cannot sample stat '%s', only scalars, vectors "
+                      "and formulas can be sampled\n", name);
+            watched.push_back(w);
+        }
+
+        output = simout.create(filename);
+        std::ostream &os = *output->stream();
+        os.precision(12);
+        os << "# tick";
+        for (const auto &name : names)
+            os << " " << name;
+        os << "\n";
+    }
+
+  public:
+    StatSampler()
+        : count(0), output(nullptr), exitRegistered(false)
+    {
+    }
+
+    void
+    start(const std::vector<std::string> &_names, size_t capacity,
+          const std::string &_filename)
+    {
+        flush();
+        if (output)
+            simout.close(output);
+        output = nullptr;
+
+        names = _names;
+        filename = _filename;
+        ticks.assign(std::max<size_t>(capacity, 1), 0);
+        values.assign(ticks.size() * names.size(), 0.0);
+        count = 0;
+
+        if (!exitRegistered) {
+            registerExitCallback(this);
+            exitRegistered = true;
+        }
+    }
+
+    void
+    sample()
+    {
+        if (!output)
+            resolve();
+
+        ticks[count] = curTick();
+        double *row = &values[count * watched.size()];
+        for (const auto &w : watched)
+            *row++ = w.scalar ? w.scalar->result() : w.vector->total();
+
+        if (++count == ticks.size())
+            flush();
+    }
+
+    void
+    flush()
+    {
+        if (!output || !count)
+            return;
+
+        std::ostream &os = *output->stream();
+        const double *row = &values[0];
+        for (size_t i = 0; i < count; ++i) {
+            os << ticks[i];
+            for (size_t j = 0; j < watched.size(); ++j)
+                os << " " << *row++;
+            os << "\n";
+        }
+        os.flush();
+        count = 0;
+    }
+
+    /** Write out what is left at exit */
+    void process() override { flush(); }
+};
+
+StatSampler statSampler;
+
+/**
+ * Event to sample the watched statistics.
+ */
+class StatSampleEvent : public GlobalEvent
+{
+  private:
+    Tick repeat;
+
+  public:
+    StatSampleEvent(Tick _when, Tick _repeat)
+        : GlobalEvent(_when, Stat_Event_Pri, 0), repeat(_repeat)
+    {
+    }
+
+    void
+    process() override
+    {
+        statSampler.sample();
+        sampleEvent = new StatSampleEvent(curTick() + repeat, repeat);
+    }
+
+    const char *description() const { return "GlobalStatSampleEvent"; }
+};
+
+void
+periodicStatSample(Tick period, const std::vector<std::string> &names,
+                   size_t capacity, const std::string &filename)
+{
+    if (sampleEvent != NULL && sampleEvent->scheduled()) {
+        // Event should AutoDelete, so we do not need to free it.
+        sampleEvent->deschedule();
+    }
+
+    if (period == 0 || names.empty()) {
+        statSampler.flush();
+        return;
+    }
+
+    statSampler.start(names, capacity, filename);
+
+    // as for the dumps, make sure the first sample happens after the
+    // event queues have synchronised
+    sampleEvent = new StatSampleEvent(
+        (period >= curTick() ? period : period + curTick()) + simQuantum,
+        period);
+}
+
 void
 updateEvents()
 {
@@ -298,6 +466,11 @@ updateEvents()
         Tick _when = dumpEvent->when();
         dumpEvent->reschedule(_when + curTick());
     }
+
+    if (sampleEvent != NULL &&
+        (sampleEvent->scheduled() && sampleEvent->when() < curTick())) {
+        sampleEvent->reschedule(sampleEvent->when() + curTick());
+    }
 }
 
 } // namespace Stats
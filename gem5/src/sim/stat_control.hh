@@ -44,6 +44,9 @@
 #ifndef __SIM_STAT_CONTROL_HH__
 #define __SIM_STAT_CONTROL_HH__
 
+#include <string>
+#include <vector>
+
 #include "base/types.hh"
 #include "sim/core.hh"
 
@@ -84,6 +87,25 @@ void schedStatEvent(bool dump, bool reset, Tick when = curTick(),
  * @param period The period at which the dumping should occur.
  */
 void periodicStatDump(Tick period = 0);
+
+/**
+ * Schedule periodic sampling of a few watched statistics. Each sample
+ * only reads the current values of the named stats into a
+ * preallocated buffer, without formatting or resetting anything, so it
+ * can be taken far more often than a dump. The buffer is written out
+ * as a time series, one line per sample, whenever it fills up and at
+ * exit. Names are resolved at the first sample, so this can be called
+ * before the stats are registered.
+ * @param period The period at which the sampling should occur, 0 stops
+ *               sampling.
+ * @param names Names of the scalar, vector or formula stats to sample,
+ *              vectors are sampled as their total.
+ * @param capacity Number of samples buffered before writing them out.
+ * @param filename Name of the time-series file in the output directory.
+ */
+void periodicStatSample(Tick period, const std::vector<std::string> &names,
+                        size_t capacity = 4096,
+                        const std::string &filename = "stats_samples.txt");
 } // namespace Stats
 
 #endif // __SIM_STAT_CONTROL_HH__
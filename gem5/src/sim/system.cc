@@ -92,7 +92,7 @@ System::System(Params *p)
       multiThread(p->multi_thread),
       pagePtr(0),
       init_param(p->init_param),
-      physProxy(_systemPort, p->cache_line_size),
+      physProxy(_systemPort, p->cache_line_size, this),
       kernelSymtab(nullptr),
       kernel(nullptr),
       loadAddrMask(p->load_addr_mask),
@@ -102,8 +102,10 @@ System::System(Params *p)
 #else
       kvmVM(nullptr),
 #endif
-      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve),
+      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve,
+              p->mmap_huge_pages),
       memoryMode(p->mem_mode),
+      _functionalBackdoor(p->functional_backdoor),
       _cacheLineSize(p->cache_line_size),
       workItemsBegin(0),
       workItemsEnd(0),
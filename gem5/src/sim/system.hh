@@ -167,6 +167,17 @@ class System : public MemObject
     }
     /** @} */
 
+    /**
+     * May functional accesses bypass the memory system and go
+     * straight to the backing store? This is only coherent when no
+     * cache holds guest data and no packets are in flight, i.e. when
+     * caches are bypassed, or in atomic mode when the configuration
+     * has no caches.
+     */
+    bool functionalBackdoor() const {
+        return bypassCaches() || (_functionalBackdoor && isAtomicMode());
+    }
+
     /** @{ */
     /**
      * Get the memory mode of the system.
@@ -309,6 +320,8 @@ class System : public MemObject
 
     Enums::MemoryMode memoryMode;
 
+    const bool _functionalBackdoor;
+
     const unsigned int _cacheLineSize;
 
     uint64_t workItemsBegin;
@@ -0,0 +1,192 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script renders a binary debug trace, written by gem5 with
+# --debug-format=binary, as the text the regular debug output would
+# have contained. See src/base/binary_trace.hh for the file format.
+
+from __future__ import print_function
+
+import argparse
+import gzip
+import re
+import struct
+import sys
+
+MAX_TICK = 2**64 - 1
+NO_NAME = 0xffffffff
+
+SIGNED, UNSIGNED, DOUBLE, CHAR, STRING, POINTER = range(1, 7)
+
+spec_re = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?'
+                     r'(?:hh|h|ll|l|q|L|j|z|t)?([diouxXeEfgGcsp%])')
+
+class Reader(object):
+    def __init__(self, f):
+        self.f = f
+
+    def read(self, fmt):
+        size = struct.calcsize(fmt)
+        data = self.f.read(size)
+        if len(data) < size:
+            raise EOFError
+        return struct.unpack(fmt, data)
+
+    def string(self):
+        (length,) = self.read('=I')
+        data = self.f.read(length)
+        if len(data) < length:
+            raise EOFError
+        return data.decode('utf-8', 'replace')
+
+    def arg(self):
+        (kind,) = self.read('=B')
+        if kind == SIGNED:
+            return kind, self.read('=q')[0]
+        if kind in (UNSIGNED, POINTER):
+            return kind, self.read('=Q')[0]
+        if kind == DOUBLE:
+            return kind, self.read('=d')[0]
+        if kind == CHAR:
+            return kind, self.read('=c')[0].decode('latin-1')
+        if kind == STRING:
+            return kind, self.string()
+        raise ValueError("unknown argument type %d" % kind)
+
+def format_arg(flags, width, prec, conv, arg):
+    kind, value = arg
+    spec = '%' + flags + (width or '') + ('.' + prec if prec else '')
+
+    if kind in (SIGNED, UNSIGNED, POINTER):
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xff)
+        if conv == 'p' or (kind == POINTER and conv == 's'):
+            return (spec + 's') % ('0x%x' % value)
+        if conv == 's':
+            return (spec + 's') % value
+        if conv in 'eEfgG':
+            return (spec + conv) % float(value)
+        if conv in 'oxX' and value < 0:
+            value &= MAX_TICK
+        if conv == 'o' and '#' in flags:
+            return (spec.replace('#', '') + 's') % ('0%o' % value)
+        return (spec + conv) % value
+
+    if kind == DOUBLE:
+        if conv in 'eEfgG':
+            return (spec + conv) % value
+        return (spec + 's') % ('%g' % value)
+
+    if kind == CHAR:
+        if conv in 'cs':
+            return (spec + 's') % value
+        return (spec + 'd') % ord(value)
+
+    return (spec + 's') % value
+
+def render(fmt, args):
+    out = []
+    pos = 0
+    args = iter(args)
+    for m in spec_re.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        try:
+            if width == '*':
+                width = str(next(args)[1])
+            if prec == '*':
+                prec = str(next(args)[1])
+            out.append(format_arg(flags, width, prec, conv, next(args)))
+        except StopIteration:
+            out.append('<missing arg for format>')
+    out.append(fmt[pos:])
+    for arg in args:
+        out.append('<extra arg>')
+    return ''.join(out)
+
+def decode(f, out):
+    r = Reader(f)
+    magic = f.read(8)
+    if magic != b'gem5btr\0':
+        sys.exit("Not a binary gem5 debug trace")
+    (version,) = r.read('=I')
+    if version != 1:
+        sys.exit("Unsupported trace version %d" % version)
+
+    formats = {}
+    names = {}
+    while True:
+        try:
+            (kind,) = r.read('=B')
+        except EOFError:
+            break
+
+        try:
+            if kind == ord('F'):
+                (i,) = r.read('=I')
+                formats[i] = r.string()
+            elif kind == ord('N'):
+                (i,) = r.read('=I')
+                names[i] = r.string()
+            elif kind == ord('M'):
+                when, name, fmt, count = r.read('=QIIB')
+                args = [r.arg() for i in range(count)]
+                line = ''
+                if when != MAX_TICK:
+                    line += '%7d: ' % when
+                if name != NO_NAME:
+                    line += names[name] + ': '
+                out.write(line + render(formats[fmt], args))
+            else:
+                sys.exit("Corrupt trace, unknown record type %d" % kind)
+        except EOFError:
+            print("Trace ends with a truncated record", file=sys.stderr)
+            break
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary gem5 debug trace to text.")
+    parser.add_argument("trace", help="binary trace, optionally gzipped")
+    parser.add_argument("output", nargs='?', default=None,
+                        help="text output [Default: stdout]")
+    args = parser.parse_args()
+
+    opener = gzip.open if args.trace.endswith('.gz') else open
+    with opener(args.trace, 'rb') as f:
+        if args.output:
+            with open(args.output, 'w') as out:
+                decode(f, out)
+        else:
+            decode(f, sys.stdout)
+
+if __name__ == "__main__":
+    main()
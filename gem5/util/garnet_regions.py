@@ -0,0 +1,137 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Run the garnet synthetic traffic on a mesh with the routers split
+# into an increasing number of regions (event queues), check that every
+# simulated stat matches the single region run, and report the speedup
+# of each region count over it. Run it from the gem5 directory, e.g.:
+#
+#   util/garnet_regions.py --regions 1,2,4,8 build/NULL/gem5.opt
+
+from __future__ import print_function
+
+import optparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+parser = optparse.OptionParser(usage="%prog [options] <gem5 binary>")
+
+parser.add_option('--regions', type='string', default='1,2,4,8',
+                  help='Comma-separated region counts, the first one is '
+                  'the reference [default: %default]')
+parser.add_option('--mesh-rows', type='int', default=8,
+                  help='Rows of the square mesh [default: %default]')
+parser.add_option('--sim-cycles', type='int', default=100000,
+                  help='Simulated network cycles [default: %default]')
+parser.add_option('--injectionrate', type='float', default=0.1,
+                  help='Packets per node per cycle [default: %default]')
+parser.add_option('--keep', action='store_true', default=False,
+                  help='Keep the output directories of the runs')
+
+(options, args) = parser.parse_args()
+
+if len(args) != 1:
+    parser.error('Expecting a single argument specifying the gem5 binary')
+
+gem5 = args[0]
+if not os.access(gem5, os.X_OK):
+    print('Error: cannot execute %s' % gem5)
+    sys.exit(1)
+
+regions = [ int(r) for r in options.regions.split(',') if r ]
+nodes = options.mesh_rows * options.mesh_rows
+
+def read_stats(stats_file):
+    """Get the simulated stats of a stats file, leaving out the host
+    ones that depend on the run."""
+    stats = []
+    with open(stats_file) as f:
+        for line in f:
+            if not line.strip() or line.startswith('-'):
+                continue
+            if re.match(r'^host_', line):
+                continue
+            # drop the description
+            stats.append(line.split('#')[0].split())
+    return stats
+
+def run(num_regions, outdir):
+    """Run the traffic with a number of regions, returning its stats and
+    wall-clock time."""
+    cmd = [ gem5, '-d', outdir, 'configs/example/garnet_synth_traffic.py',
+            '--network=garnet2.0', '--topology=Mesh_XY',
+            '--num-cpus=%d' % nodes, '--num-dirs=%d' % nodes,
+            '--mesh-rows=%d' % options.mesh_rows,
+            '--sim-cycles=%d' % options.sim_cycles,
+            '--injectionrate=%f' % options.injectionrate,
+            '--synthetic=uniform_random',
+            '--garnet-regions=%d' % num_regions ]
+
+    log = open(os.path.join(outdir, 'log.txt'), 'w')
+    start = time.time()
+    status = subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT)
+    wall = time.time() - start
+    log.close()
+
+    if status != 0:
+        print('Error: %s failed, see %s' %
+              (' '.join(cmd), os.path.join(outdir, 'log.txt')))
+        sys.exit(1)
+
+    return read_stats(os.path.join(outdir, 'stats.txt')), wall
+
+outbase = tempfile.mkdtemp(prefix='garnet_regions.')
+
+mismatches = []
+print('%8s %10s %8s %s' % ('regions', 'seconds', 'speedup', 'stats'))
+for r in regions:
+    outdir = os.path.join(outbase, str(r))
+    os.makedirs(outdir)
+    stats, wall = run(r, outdir)
+    if r == regions[0]:
+        ref_stats, ref_wall = stats, wall
+    same = stats == ref_stats
+    if not same:
+        mismatches.append(r)
+    print('%8d %10.2f %8.2f %s' % (r, wall, ref_wall / wall,
+                                    'match' if same else 'DIFFER'))
+
+if options.keep:
+    print('Run directories kept in %s' % outbase)
+else:
+    shutil.rmtree(outbase)
+
+if mismatches:
+    print('Stats differ from the %d region run for %s regions' %
+          (regions[0], ', '.join(str(r) for r in mismatches)))
+    sys.exit(1)
@@ -0,0 +1,126 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script follows the windows a CommMonitor exports to shared
+# memory (see the export_shm parameter and src/mem/monitor_export.hh)
+# and prints one line per window while the simulation runs.
+
+from __future__ import print_function
+
+import argparse
+import mmap
+import os
+import struct
+import sys
+import time
+
+HEADER = struct.Struct('=8s4I4Q')
+HEADER_SIZE = 64
+QUANTILES = ('p50', 'p90', 'p99', 'p999')
+
+def window_struct(heat_bins):
+    # seq, index, start, end, read/write requests and bytes, read and
+    # write bandwidth, read and write latency quantiles, heat map
+    return struct.Struct('=8Q2d%dd%dd%dQ' % (len(QUANTILES), len(QUANTILES),
+                                             heat_bins))
+
+def read_window(buf, offset, fmt):
+    # Retry until the slot was not being written while it was copied
+    while True:
+        (before,) = struct.unpack_from('=Q', buf, offset)
+        data = fmt.unpack_from(buf, offset)
+        (after,) = struct.unpack_from('=Q', buf, offset)
+        if before == after and before % 2 == 0:
+            return data
+        time.sleep(0.001)
+
+def heat_line(heat):
+    marks = ' .:-=+*#%@'
+    peak = max(heat)
+    if not peak:
+        return ''
+    return ''.join(marks[(len(marks) - 1) * h // peak] for h in heat)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Follow the windows exported by a CommMonitor.")
+    parser.add_argument("name", help="shared memory segment (export_shm)")
+    parser.add_argument("--interval", type=float, default=0.2,
+                        help="polling interval in seconds [Default: 0.2]")
+    parser.add_argument("--heat", action="store_true",
+                        help="also print the address heat map")
+    args = parser.parse_args()
+
+    path = os.path.join('/dev/shm', args.name.lstrip('/'))
+    with open(path, 'rb') as f:
+        buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+    (magic, version, slot_size, num_slots, heat_bins, ticks_per_sec,
+     heat_start, heat_end, windows) = HEADER.unpack_from(buf, 0)
+    if magic != b'gem5mon\0' or version != 1:
+        sys.exit("%s is not a CommMonitor export" % path)
+    fmt = window_struct(heat_bins)
+    if fmt.size != slot_size:
+        sys.exit("Unexpected window size %d" % slot_size)
+
+    ns_per_tick = 1e9 / ticks_per_sec
+    print("%-8s %12s %10s %10s %6s  %s" %
+          ("window", "end(ns)", "rd MB/s", "wr MB/s", "rd%",
+           "  ".join("rd %s(ns)" % q for q in QUANTILES)))
+
+    seen = 0
+    try:
+        while True:
+            (windows,) = struct.unpack_from('=Q', buf, HEADER.size - 8)
+            # Skip the windows that were overwritten before we got there
+            seen = max(seen, windows - num_slots)
+            while seen < windows:
+                w = read_window(buf, HEADER_SIZE +
+                                (seen % num_slots) * slot_size, fmt)
+                seen += 1
+                if w[1] != seen - 1:
+                    continue
+                (_, index, start, end, rd, wr, rd_bytes, wr_bytes,
+                 rd_bw, wr_bw) = w[:10]
+                rd_lat = w[10:10 + len(QUANTILES)]
+                heat = w[10 + 2 * len(QUANTILES):]
+                reqs = rd + wr
+                print("%-8d %12d %10.1f %10.1f %5.1f%%  %s" %
+                      (index, end * ns_per_tick, rd_bw / 1e6, wr_bw / 1e6,
+                       100.0 * rd / reqs if reqs else 0,
+                       "  ".join("%11.1f" % (l * ns_per_tick)
+                                 for l in rd_lat)))
+                if args.heat:
+                    print("         [%s]" % heat_line(heat))
+            sys.stdout.flush()
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+
+if __name__ == "__main__":
+    main()
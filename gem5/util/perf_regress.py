@@ -0,0 +1,274 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2025 The gem5 Project contributors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Host performance regression suite. This script runs gem5 on a fixed
+# set of configurations, several times each, and reports the median
+# simulation rate, host time and peak resident memory of each as JSON.
+# Given the JSON of an earlier run as a baseline it fails (exit code 1)
+# if any configuration got slower or bigger by more than a threshold.
+#
+# The CPU models run the memory kernels in benchmark/kernels, build them
+# first with make in that directory. Rates are taken from the stats dump
+# the kernels take at the end of their region of interest. Run it from
+# the gem5 directory, e.g.:
+#
+#   util/perf_regress.py --output before.json build/X86/gem5.opt
+#   ... change things and rebuild ...
+#   util/perf_regress.py --baseline before.json build/X86/gem5.opt
+
+from __future__ import print_function
+
+import json
+import optparse
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+# The configurations, each a list of arguments to gem5, the stat used
+# as the simulation rate, and the kernel run on the CPU models with its
+# arguments. The sizes are fixed so that every configuration simulates
+# for long enough (tens of seconds) for the rate not to be dominated by
+# start-up and noise. The placeholder {kernel} is replaced by the path
+# of the kernel binary.
+se_caches = [ '--caches', '--l2cache', '--l3cache' ]
+se_kernel = [ 'configs/example/se.py', '-c', '{kernel}' ]
+
+configs = {
+    'atomic' : (se_kernel + [ '--cpu-type=AtomicSimpleCPU' ],
+                'host_inst_rate', 'gemm', '256'),
+    'timing' : (se_kernel + [ '--cpu-type=TimingSimpleCPU' ] + se_caches,
+                'host_inst_rate', 'stream', '524288 4'),
+    'o3' : (se_kernel + [ '--cpu-type=DerivO3CPU' ] + se_caches,
+            'host_inst_rate', 'chase', '16777216 2000000'),
+    'ruby' : (se_kernel + [ '--cpu-type=TimingSimpleCPU', '--ruby' ],
+              'host_inst_rate', 'gups', '1048576 1000000'),
+    'tgen' : ([ 'configs/dram/closed_loop.py', '--num-gens=8',
+                '--max-mlp=8', '--period=20000000' ],
+              'host_tick_rate', None, None),
+}
+
+parser = optparse.OptionParser(usage="%prog [options] <gem5 binary>")
+
+parser.add_option('--configs', type='string',
+                  default=','.join(sorted(configs)),
+                  help='Comma-separated configurations to run '
+                  '[default: %default]')
+parser.add_option('--runs', type='int', default=3,
+                  help='Number of runs of each configuration '
+                  '[default: %default]')
+parser.add_option('--kernels', type='string',
+                  default='../benchmark/kernels',
+                  help='Directory of the kernel binaries run on the CPU '
+                  'models [default: %default]')
+parser.add_option('--kernel-options', type='string', default=None,
+                  help='Arguments of the kernels, replacing the sizes of '
+                  'every configuration')
+parser.add_option('--output', type='string', default='',
+                  help='Write the results as JSON to this file')
+parser.add_option('--baseline', type='string', default='',
+                  help='JSON results of an earlier run to compare with')
+parser.add_option('--threshold', type='float', default=0.05,
+                  help='Relative slowdown or memory growth that counts '
+                  'as a regression [default: %default]')
+parser.add_option('--keep', action='store_true', default=False,
+                  help='Keep the output directories of the runs')
+
+(options, args) = parser.parse_args()
+
+if len(args) != 1:
+    parser.error('Expecting a single argument specifying the gem5 binary')
+
+gem5 = args[0]
+if not os.access(gem5, os.X_OK):
+    print('Error: cannot execute %s' % gem5)
+    sys.exit(1)
+
+selected = [ c for c in options.configs.split(',') if c ]
+for c in selected:
+    if c not in configs:
+        print('Error: unknown configuration %s, choose from %s' %
+              (c, ', '.join(sorted(configs))))
+        sys.exit(1)
+
+for c in selected:
+    kernel = configs[c][2]
+    if kernel and not os.path.isfile(os.path.join(options.kernels, kernel)):
+        print('Error: cannot find the kernel %s, build it with make in %s' %
+              (kernel, options.kernels))
+        sys.exit(1)
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+def read_stats(stats_file):
+    """Get the host stats of the first dump in a stats file, which is
+    the one a kernel takes at the end of its region of interest."""
+    stats = {}
+    stat_re = re.compile(r'^(host_\w+|sim_insts|sim_ticks)\s+([\d.]+)')
+    with open(stats_file) as f:
+        for line in f:
+            if line.startswith('---------- End Simulation Statistics'):
+                break
+            m = stat_re.match(line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+def run_once(name, outdir):
+    """Run a configuration once, returning its stats, wall-clock time
+    and peak resident memory in kB."""
+    gem5_args, rate_stat, kernel, sizes = configs[name]
+    if kernel and options.kernel_options is not None:
+        sizes = options.kernel_options
+    cmd = [ gem5, '-d', outdir ]
+    for a in gem5_args:
+        if kernel:
+            a = a.replace('{kernel}', os.path.join(options.kernels, kernel))
+        cmd.append(a)
+    if sizes:
+        cmd += [ '-o', sizes ]
+
+    log = open(os.path.join(outdir, 'log.txt'), 'w')
+    start = time.time()
+    proc = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+    # wait4 gives the resource usage of this child alone
+    pid, status, usage = os.wait4(proc.pid, 0)
+    wall = time.time() - start
+    log.close()
+
+    if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+        print('Error: %s failed, see %s' %
+              (' '.join(cmd), os.path.join(outdir, 'log.txt')))
+        sys.exit(1)
+
+    stats = read_stats(os.path.join(outdir, 'stats.txt'))
+    if rate_stat not in stats:
+        print('Error: %s did not report %s' % (name, rate_stat))
+        sys.exit(1)
+
+    # ru_maxrss is in kB on Linux and bytes on macOS
+    rss = usage.ru_maxrss
+    if platform.system() == 'Darwin':
+        rss //= 1024
+
+    return stats, wall, rss
+
+results = {
+    'gem5' : os.path.abspath(gem5),
+    'host' : platform.node(),
+    'date' : time.strftime('%Y-%m-%d %H:%M:%S'),
+    'runs' : options.runs,
+    'configs' : {},
+}
+
+outbase = tempfile.mkdtemp(prefix='perf_regress.')
+
+for name in selected:
+    rate_stat = configs[name][1]
+    rates, walls, rsses = [], [], []
+    for i in range(options.runs):
+        outdir = os.path.join(outbase, '%s.%d' % (name, i))
+        os.makedirs(outdir)
+        stats, wall, rss = run_once(name, outdir)
+        rates.append(stats[rate_stat])
+        walls.append(wall)
+        rsses.append(rss)
+        print('%-8s run %d: %s %.0f, %.2f s, %d kB' %
+              (name, i, rate_stat, stats[rate_stat], wall, rss))
+
+    entry = {
+        'rate_stat' : rate_stat,
+        'rate' : median(rates),
+        'wall_seconds' : median(walls),
+        'peak_rss_kb' : max(rsses),
+        'samples' : { 'rate' : rates, 'wall_seconds' : walls,
+                      'peak_rss_kb' : rsses },
+    }
+    if rate_stat == 'host_inst_rate':
+        entry['kips'] = entry['rate'] / 1000.0
+    results['configs'][name] = entry
+
+if options.keep:
+    print('Run directories kept in %s' % outbase)
+else:
+    shutil.rmtree(outbase)
+
+if options.output:
+    with open(options.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+else:
+    json.dump(results, sys.stdout, indent=2, sort_keys=True)
+    print()
+
+if not options.baseline:
+    sys.exit(0)
+
+with open(options.baseline) as f:
+    baseline = json.load(f)['configs']
+
+# compare the medians of the rate and the peak memory, either getting
+# worse by more than the threshold is a regression
+regressions = []
+print('%-8s %14s %14s %8s %12s %12s %8s' %
+      ('config', 'base rate', 'rate', 'change', 'base rss kB', 'rss kB',
+       'change'))
+for name in selected:
+    if name not in baseline:
+        print('%-8s not in baseline' % name)
+        continue
+    old, new = baseline[name], results['configs'][name]
+    rate_change = new['rate'] / old['rate'] - 1.0
+    rss_change = float(new['peak_rss_kb']) / old['peak_rss_kb'] - 1.0
+    print('%-8s %14.0f %14.0f %+7.1f%% %12d %12d %+7.1f%%' %
+          (name, old['rate'], new['rate'], rate_change * 100,
+           old['peak_rss_kb'], new['peak_rss_kb'], rss_change * 100))
+    if rate_change < -options.threshold:
+        regressions.append('%s: %s down %.1f%%' %
+                           (name, new['rate_stat'], -rate_change * 100))
+    if rss_change > options.threshold:
+        regressions.append('%s: peak RSS up %.1f%%' %
+                           (name, rss_change * 100))
+
+if regressions:
+    print('Performance regressions beyond %.1f%%:' %
+          (options.threshold * 100))
+    for r in regressions:
+        print('  ' + r)
+    sys.exit(1)
+
+print('No performance regressions beyond %.1f%%' %
+      (options.threshold * 100))